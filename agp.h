@@ -23,608 +23,5689 @@
 
 #include<cmath>
 #include<stdexcept>
+#include<exception>
 #include<iostream>
 #include<initializer_list>
+#include<vector>
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<limits>
+#include<cstdio>
+#include<cstring>
+#include<cstdlib>
+
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AGP_X86
+#include<immintrin.h>
+#endif
+
+
+// Builds Without Exceptions (-fno-exceptions) Print the Message and Abort
+// Where the Throwing Functions Would Throw. The Try*() Functions Never Throw
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define AGP_EXCEPTIONS
+#define AGP_THROW(message) throw std::runtime_error(message)
+#else
+#define AGP_THROW(message) (fprintf(stderr, "agp: %s\n", message), abort())
+#endif
+
+
+// Result of a Try*() Function. Anything but status_ok Leaves the Object As it Was.
+// Try*() Functions are Never Traced, as AGP_TRACE_SCOPE Can Allocate; Only
+// Their Throwing Wrappers are
+enum agp_status { status_ok, status_parallel_vectors, status_camera_at_center, status_negative_radius,
+    status_percentage_out_of_bounds, status_nlerp_undefined, status_index_out_of_bounds, status_size_mismatch };
+
+
+// Message the Throwing Functions Raise for status
+const char *StatusMessage(const agp_status status) noexcept {
+    switch(status){
+        case status_ok: return "Ok";
+        case status_parallel_vectors: return "Camera and Up Vectors Parallel";
+        case status_camera_at_center: return "Camera at Center";
+        case status_negative_radius: return "Radius Negative";
+        case status_percentage_out_of_bounds: return "Out of Bounds Percentage";
+        case status_nlerp_undefined: return "nlerp Undefined at 180 Degrees";
+        case status_index_out_of_bounds: return "Index Out of Bounds";
+        case status_size_mismatch: return "Size Mismatch";
+    }
+    return "Unknown Status";
+}
 
 
-// result = matrix_1 * matrix_2 in row major order
-void Mat4MultiplyMat4T(const float * __restrict__ mat4_1, 
-const float * __restrict__ mat4_2, float * __restrict__ out){
-    for (int i=0; i<4; i++){
-        for (int j=0; j<4; j++){
-               out[i*4 + j] = 0;
-            for (int k=0; k<4; k++){
-                out[i*4 + j] += mat4_1[i*4 + k]*mat4_2[j*4 + k];
-            }
-        }
-    }
+// Throws StatusMessage(status) Unless it is status_ok. The Throwing
+// Functions are This Wrapped Around Their Try*() Version
+void ThrowOnError(const agp_status status){
+    if(status != status_ok){AGP_THROW(StatusMessage(status));}
 }
 
 
-void TransposeMat4(float *__restrict__ mat4_in, float *__restrict__ mat4_out){
-    for(int i=0; i<4; i++){
-        for(int j=0; j<4; j++){
-            mat4_out[i*4 + j] = mat4_in[j*4 + i];
-        }
-    }
+// Error Policies for the Try*() Functions, Picked at Compile Time e.g.
+// arc.TrySetRadius<error_clamp>(r). error_report Returns the Status,
+// error_clamp Moves an Out of Range Input to the Nearest Valid Value and
+// Returns status_ok. Errors With No Nearest Value are Reported by Both
+struct error_report{static constexpr bool is_clamped = false;};
+
+struct error_clamp{static constexpr bool is_clamped = true;};
+
+
+// Optional Tracing. Define AGP_ENABLE_TRACING Before Including agp.h to
+// Time the Camera, Quaternion and Matrix Hot Paths. Without it the Hooks
+// Compile to Nothing
+#ifdef AGP_ENABLE_TRACING
+#include<chrono>
+#include<memory>
+
+#define AGP_TRACE_CAT2(a, b) a##b
+#define AGP_TRACE_CAT(a, b) AGP_TRACE_CAT2(a, b)
+
+// Times the Rest of the Enclosing Scope Under name
+#define AGP_TRACE_SCOPE(name) \
+    static const uint32_t AGP_TRACE_CAT(agp_trace_site_, __LINE__) = TraceSite(name); \
+    trace_scope AGP_TRACE_CAT(agp_trace_scope_, __LINE__)(AGP_TRACE_CAT(agp_trace_site_, __LINE__))
+
+#define AGP_TRACE_FRAME() TraceFrame()
+
+// Histogram Bin i Counts Frames Where a Site Took [2^i, 2^(i+1)) Cycles
+const int trace_histogram_bins = 64;
+
+// Events Kept per Thread for the Chrome Trace, Later Ones are Counted as Dropped
+const size_t trace_event_capacity = 1 << 20;
+
+
+// Time Stamp Counter Where Available, Otherwise Nanoseconds
+uint64_t TraceCycles(){
+#ifdef AGP_X86
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
 }
 
 
-void PrintMat4(const float *matrix, const char* name){
-    std::cout<<name<<" = { ";
-    int spaces = sizeof(name)/sizeof(name[0]);
-    int dim = 4; // Can Make for Arbitrary Square Dim
-    for(int i=0;i<dim;i++){
-        for(int j=0;j<dim - 1;j++){
-            std::cout<<std::to_string(matrix[i*dim + j])<<", ";
-        }
-        std::cout<<std::to_string(matrix[i*dim + dim - 1]);
-        if(i < dim - 1){
-            std::cout<<", \n";
-            for(int j=0;j<spaces;j++){
-                std::cout<<" ";
-            }
-        }
+struct trace_stats{
+    const char *name;
+    uint64_t calls;
+    uint64_t cycles;
+    // Per Frame Cycles, Counted Each TraceFrame() the Site Ran in
+    uint64_t histogram[trace_histogram_bins];
+};
+
+struct trace_event{
+    uint32_t site;
+    uint64_t begin;
+    uint64_t cycles;
+};
+
+// Written Only by its Own Thread
+struct trace_buffer{
+    unsigned thread_index;
+    std::vector<trace_stats> stats;
+    std::vector<uint64_t> frame_cycles;
+    std::vector<trace_event> events;
+    uint64_t dropped_events = 0;
+};
+
+// Buffers Outlive Their Threads so a Finished Worker's Trace Can Still be Exported
+struct trace_registry{
+    std::mutex mutex;
+    std::vector<const char*> sites;
+    std::vector<std::unique_ptr<trace_buffer> > buffers;
+    uint64_t start_cycles = TraceCycles();
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+};
+
+trace_registry &TraceRegistry(){
+    static trace_registry registry;
+    return registry;
+}
+
+
+// Id for name, the Same for Every Scope Using an Equal String
+uint32_t TraceSite(const char *name){
+    trace_registry &registry = TraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for(size_t i=0; i<registry.sites.size(); i++){
+        if(strcmp(registry.sites[i], name) == 0){return (uint32_t)i;}
     }
-    std::cout<<" }\n";
+    registry.sites.push_back(name);
+    return (uint32_t)(registry.sites.size() - 1);
 }
 
-template<int N>
-void NormalizeVec(float *vec3){
-    float magnitude = 0;
-    for(int i=0; i<N; i++){
-        magnitude += vec3[i]*vec3[i];
+trace_buffer &TraceBuffer(){
+    static thread_local trace_buffer *buffer = 0;
+    if(!buffer){
+        trace_registry &registry = TraceRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.buffers.push_back(std::unique_ptr<trace_buffer>(new trace_buffer()));
+        buffer = registry.buffers.back().get();
+        buffer->thread_index = (unsigned)registry.buffers.size() - 1;
+        buffer->events.reserve(1 << 16);
     }
-    magnitude = 1/sqrt(magnitude);
+    return *buffer;
+}
 
-    for(int i=0; i<N; i++){
-        vec3[i] = vec3[i]*magnitude;
+void TraceRecord(const uint32_t site, const uint64_t begin, const uint64_t cycles){
+    trace_buffer &buffer = TraceBuffer();
+    if(site >= buffer.stats.size()){
+        trace_stats empty = {0, 0, 0, {0}};
+        buffer.stats.resize(site + 1, empty);
+        buffer.frame_cycles.resize(site + 1, 0);
+    }
+    buffer.stats[site].calls++;
+    buffer.stats[site].cycles += cycles;
+    buffer.frame_cycles[site] += cycles;
+    if(buffer.events.size() < trace_event_capacity){
+        trace_event event = {site, begin, cycles};
+        buffer.events.push_back(event);
+    }
+    else{
+        buffer.dropped_events++;
     }
 }
 
 
-void CrossVec(const float * __restrict__ left_vec, 
-const float * __restrict__ right_vec, float * __restrict__ return_vec){
-    return_vec[0] = left_vec[1]*right_vec[2] - left_vec[2]*right_vec[1];
-    return_vec[1] = left_vec[2]*right_vec[0] - left_vec[0]*right_vec[2];
-    return_vec[2] = left_vec[0]*right_vec[1] - left_vec[1]*right_vec[0];
+class trace_scope{
+
+public:
+
+explicit trace_scope(const uint32_t site) : site(site), begin(TraceCycles()) {}
+
+~trace_scope(){
+    TraceRecord(site, begin, TraceCycles() - begin);
 }
 
-template<int N>
-float DotVec(const float * __restrict__ vec1, const float * __restrict__ vec2){
-    float output = 0;
-    for (int i=0; i<N; i++){
-        output += vec1[i]*vec2[i];
+private:
+
+trace_scope(const trace_scope &);
+
+trace_scope &operator=(const trace_scope &);
+
+uint32_t site;
+
+uint64_t begin;
+
+};
+
+
+// Ends the Calling Thread's Frame, Adding Each Site's Cycles Since the
+// Last Call to its Histogram
+void TraceFrame(){
+    trace_buffer &buffer = TraceBuffer();
+    for(size_t i=0; i<buffer.frame_cycles.size(); i++){
+        uint64_t cycles = buffer.frame_cycles[i];
+        if(cycles == 0){continue;}
+        int bin = 0;
+        while(bin < trace_histogram_bins - 1 && (cycles >> (bin + 1)) != 0){bin++;}
+        buffer.stats[i].histogram[bin]++;
+        buffer.frame_cycles[i] = 0;
     }
-    return output;
 }
 
 
-// outvec = vec1 - vec2
-template<int N>
-void DiffVec(const float * __restrict__ vec1, const float * __restrict__ vec2,
- float * __restrict__ outvec){
-    for (int i=0; i<N; i++){
-        outvec[i] = vec1[i] - vec2[i];
+// The Functions Below Read Every Thread's Buffer. Call Them While No
+// Traced Code is Running
+
+// One Entry per Site, Summed Over Threads
+std::vector<trace_stats> TraceStats(){
+    trace_registry &registry = TraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    trace_stats empty = {0, 0, 0, {0}};
+    std::vector<trace_stats> totals(registry.sites.size(), empty);
+    for(size_t i=0; i<totals.size(); i++){
+        totals[i].name = registry.sites[i];
+    }
+    for(size_t i=0; i<registry.buffers.size(); i++){
+        const trace_buffer &buffer = *registry.buffers[i];
+        for(size_t j=0; j<buffer.stats.size(); j++){
+            totals[j].calls += buffer.stats[j].calls;
+            totals[j].cycles += buffer.stats[j].cycles;
+            for(int k=0; k<trace_histogram_bins; k++){
+                totals[j].histogram[k] += buffer.stats[j].histogram[k];
+            }
+        }
     }
+    return totals;
 }
 
+// Trace Cycles per Microsecond, Measured Since the First Traced Call
+double TraceCyclesPerMicrosecond(){
+    trace_registry &registry = TraceRegistry();
+    double microseconds = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - registry.start_time).count();
+    uint64_t cycles = TraceCycles() - registry.start_cycles;
+    return (microseconds > 0 && cycles > 0) ? cycles/microseconds : 1000;
+}
 
-template<int N>
-float MagnitudeVec(const float *vec){
-    float output = 0;
-    for (int i=0; i<N; i++){
-        output += vec[i]*vec[i];
+// Writes Every Recorded Call as a Complete Event in Chrome's Trace Event
+// Format, Viewable in chrome://tracing or Perfetto
+void TraceWriteChrome(const char *path){
+    double cycles_per_us = TraceCyclesPerMicrosecond();
+    trace_registry &registry = TraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    FILE *file = fopen(path, "w");
+    if(!file){AGP_THROW("Could Not Open Trace File");}
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    bool first = true;
+    for(size_t i=0; i<registry.buffers.size(); i++){
+        const trace_buffer &buffer = *registry.buffers[i];
+        for(size_t j=0; j<buffer.events.size(); j++){
+            const trace_event &event = buffer.events[j];
+            fprintf(file, "%s{\"name\": \"%s\", \"cat\": \"agp\", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, "
+                "\"ts\": %.3f, \"dur\": %.3f}", first ? "" : ",\n", registry.sites[event.site], buffer.thread_index,
+                (double)(int64_t)(event.begin - registry.start_cycles)/cycles_per_us, event.cycles/cycles_per_us);
+            first = false;
+        }
+        if(buffer.dropped_events > 0){
+            fprintf(file, "%s{\"name\": \"dropped_events\", \"ph\": \"C\", \"pid\": 0, \"tid\": %u, \"ts\": 0, "
+                "\"args\": {\"count\": %llu}}", first ? "" : ",\n", buffer.thread_index,
+                (unsigned long long)buffer.dropped_events);
+            first = false;
+        }
     }
-    return sqrt(output);
+    fprintf(file, "\n]}\n");
+    if(fclose(file) != 0){AGP_THROW("Could Not Write Trace File");}
 }
 
+// Clears Every Thread's Counts, Histograms and Events
+void TraceReset(){
+    trace_registry &registry = TraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for(size_t i=0; i<registry.buffers.size(); i++){
+        trace_buffer &buffer = *registry.buffers[i];
+        buffer.stats.clear();
+        buffer.frame_cycles.clear();
+        buffer.events.clear();
+        buffer.dropped_events = 0;
+    }
+}
 
-//  "The engines don’t move the ship at all. The ship stays where it is 
-//  and the engines move the universe around it" -Futurama
-struct arcball{
+#else
 
-float rotate_sensitivity = 0.004;
+#define AGP_TRACE_SCOPE(name)
 
-float zoom_sensitivity = 0.2;
+#define AGP_TRACE_FRAME()
 
-float zoom_translate_sensitivity = 0.1;
+#endif
 
-void SetCamera(const float *cam_pos, const float *up){
 
-    // Find Cos(theta) between the two vectors
-    float cam_mag = 0;
-    float up_mag = 0;
-    for(int i=0; i<3; i++){
-        cam_mag += cam_pos[i]*cam_pos[i];
-        up_mag += up[i]*up[i];
-    }
-    float dotprod = DotVec<3>(cam_pos, up)/(sqrt(cam_mag)*sqrt(up_mag));
-    float dir_vec[3];
+// Instruction Sets With Explicit Kernels, Ordered so Each Level Implies the Ones Below
+enum simd_level { simd_scalar, simd_sse2, simd_avx2, simd_avx512 };
 
-    if( dotprod >= 0.999){
-        // Vectors are Facing the Same Direction
-        throw std::runtime_error("Camera and Up Vectors Parallel");
-    }
-    else if( dotprod >= 0.00001){
-        // If vectors aren't perpendicular, make them perpendicular
-        DiffVec<3>(cam_pos, center_pos, dir_vec);
 
-        float right[3];
-        CrossVec(up, dir_vec, right);
-        CrossVec(dir_vec, right, up_vec);
-    }
-    else{
-        // Vectors are Perpendicular
-        std::copy(up, up + 3, up_vec);
-        DiffVec<3>(cam_pos, center_pos, dir_vec);
-    }
+simd_level DetectSimdLevel(){
+#ifdef AGP_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){return simd_avx512;}
+    if(__builtin_cpu_supports("avx2")){return simd_avx2;}
+    if(__builtin_cpu_supports("sse2")){return simd_sse2;}
+#endif
+    return simd_scalar;
+}
 
-    std::copy(cam_pos, cam_pos + 3, camera_pos);
-    NormalizeVec<3>(up_vec);
-    FormBasis();
 
-    radius = MagnitudeVec<3>(dir_vec);
+// Detected Once on First Use
+simd_level SimdLevel(){
+    static const simd_level level = DetectSimdLevel();
+    return level;
 }
 
-void SetCenter(const float *input){
-    std::copy(input, input+3, center_pos);
-    FormBasis();
-    float dir_vec[3];
-    DiffVec<3>(camera_pos, center_pos, dir_vec);
-    radius = radius = MagnitudeVec<3>(dir_vec);
+
+// All Kernels Add the Products in the Same Order (k = 0..3) With Separate
+// Multiplies and Adds, so Every Instruction Set Gives the Same Result.
+// AGP_NO_FP_CONTRACT Stops GCC Fusing Them Into FMAs Where the Build or a
+// target Attribute Enables FMA, Which Would Round Differently
+#if defined(__GNUC__) && !defined(__clang__)
+#define AGP_NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define AGP_NO_FP_CONTRACT
+#endif
+
+// result = matrix_1 * matrix_2 in row major order
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TScalar(const float * __restrict__ mat4_1, 
+const float * __restrict__ mat4_2, float * __restrict__ out){
+    for (int i=0; i<4; i++){
+        for (int j=0; j<4; j++){
+               out[i*4 + j] = 0;
+            for (int k=0; k<4; k++){
+                out[i*4 + j] += mat4_1[i*4 + k]*mat4_2[j*4 + k];
+            }
+        }
+    }
 }
 
-void SetRadius(const float input){
-    if(input < 0){throw std::runtime_error("Radius Negative");}
-    float dir_vec[3];
-    DiffVec<3>(camera_pos, center_pos, dir_vec);
-    NormalizeVec<3>(dir_vec);
-    radius = input;
-    for (int i=0; i<3; i++){
-        camera_pos[i] = radius*dir_vec[i] + center_pos[i];
+
+void TransposeMat4Scalar(const float *__restrict__ mat4_in, float *__restrict__ mat4_out){
+    for(int i=0; i<4; i++){
+        for(int j=0; j<4; j++){
+            mat4_out[i*4 + j] = mat4_in[j*4 + i];
+        }
     }
-    FormBasis();
 }
 
-const float *Camera(){return camera_pos;}
 
-const float *Center(){return center_pos;}
+#ifdef AGP_X86
 
-void SetProjectionVars(const float fov, const float z_near, const float z_far){
-    // Change Projection Matrix Values
-    float tangent = tan(0.5*fov);
-    pixel_to_wspace_x = m00*pixel_to_wspace_x;
-    pixel_to_wspace_y = m11*pixel_to_wspace_y;
-    m00 = 1/(aspect_ratio*tangent);
-    m11 = 1/tangent;
-    pixel_to_wspace_x = aspect_ratio*tangent*pixel_to_wspace_x;
-    pixel_to_wspace_y = tangent*pixel_to_wspace_y;
-    m22 = (z_near + z_far)/(z_near - z_far);
-    m32 = 2*z_near*z_far/(z_near - z_far);
+__attribute__((target("sse2")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TSSE2(const float * __restrict__ mat4_1, 
+const float * __restrict__ mat4_2, float * __restrict__ out){
+    // Columns of matrix_2
+    __m128 col0 = _mm_loadu_ps(mat4_2);
+    __m128 col1 = _mm_loadu_ps(mat4_2 + 4);
+    __m128 col2 = _mm_loadu_ps(mat4_2 + 8);
+    __m128 col3 = _mm_loadu_ps(mat4_2 + 12);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    for(int i=0; i<4; i++){
+        __m128 row = _mm_loadu_ps(mat4_1 + i*4);
+        __m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), col0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), col1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), col2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), col3));
+        _mm_storeu_ps(out + i*4, sum);
+    }
 }
 
 
-// out_vec is a 1x3 vector containing the direction vector of the ray
-void MouseRay(const float mouse_x, const float mouse_y, float *out_vec){
+__attribute__((target("sse2")))
+void TransposeMat4SSE2(const float *__restrict__ mat4_in, float *__restrict__ mat4_out){
+    __m128 row0 = _mm_loadu_ps(mat4_in);
+    __m128 row1 = _mm_loadu_ps(mat4_in + 4);
+    __m128 row2 = _mm_loadu_ps(mat4_in + 8);
+    __m128 row3 = _mm_loadu_ps(mat4_in + 12);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(mat4_out, row0);
+    _mm_storeu_ps(mat4_out + 4, row1);
+    _mm_storeu_ps(mat4_out + 8, row2);
+    _mm_storeu_ps(mat4_out + 12, row3);
+}
 
-    // Find Local Direction Vector
-    float vec[3] = {-mouse_x*pixel_to_wspace_x, mouse_y*pixel_to_wspace_y, -1};
 
-    // Multiply Vector by the Basis Matrix Transposed
-    for (int i=0; i<3; i++){
-        out_vec[i] = basis[i]*vec[0] + basis[i + 3]*vec[1] + basis[i + 6]*vec[2];
+// Two Rows per 256 Bit Register
+__attribute__((target("avx2")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TAVX2(const float * __restrict__ mat4_1, 
+const float * __restrict__ mat4_2, float * __restrict__ out){
+    __m128 col0 = _mm_loadu_ps(mat4_2);
+    __m128 col1 = _mm_loadu_ps(mat4_2 + 4);
+    __m128 col2 = _mm_loadu_ps(mat4_2 + 8);
+    __m128 col3 = _mm_loadu_ps(mat4_2 + 12);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+    __m256 cols0 = _mm256_insertf128_ps(_mm256_castps128_ps256(col0), col0, 1);
+    __m256 cols1 = _mm256_insertf128_ps(_mm256_castps128_ps256(col1), col1, 1);
+    __m256 cols2 = _mm256_insertf128_ps(_mm256_castps128_ps256(col2), col2, 1);
+    __m256 cols3 = _mm256_insertf128_ps(_mm256_castps128_ps256(col3), col3, 1);
+
+    for(int i=0; i<4; i+=2){
+        __m256 rows = _mm256_loadu_ps(mat4_1 + i*4);
+        __m256 sum = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), cols0);
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0x55), cols1));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0xAA), cols2));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0xFF), cols3));
+        _mm256_storeu_ps(out + i*4, sum);
     }
 }
 
 
-void SetViewArea(const int window_width, const int window_height){
-    aspect_ratio = (float)window_width/(float)window_height;
-    m00 = m11*(1/aspect_ratio); // Projection Matrix Value Changes with Aspect Ratio
-    pixel_to_wspace_x = 1/(m00*0.5*window_width);
-    pixel_to_wspace_y = 1/(m11*0.5*window_height);
-}
+__attribute__((target("avx2")))
+void TransposeMat4AVX2(const float *__restrict__ mat4_in, float *__restrict__ mat4_out){
+    __m256 rows01 = _mm256_loadu_ps(mat4_in);
+    __m256 rows23 = _mm256_loadu_ps(mat4_in + 8);
 
+    // {r0[0], r2[0], r0[1], r2[1] | r1[0], r3[0], r1[1], r3[1]} and the Upper Halves
+    __m256 low = _mm256_unpacklo_ps(rows01, rows23);
+    __m256 high = _mm256_unpackhi_ps(rows01, rows23);
+    __m256 even = _mm256_permute2f128_ps(low, high, 0x20);
+    __m256 odd = _mm256_permute2f128_ps(low, high, 0x31);
 
-void Translate(const float delta_x, const float delta_y){
+    // {out row 0 | out row 2} and {out row 1 | out row 3}
+    __m256 rows02 = _mm256_unpacklo_ps(even, odd);
+    __m256 rows13 = _mm256_unpackhi_ps(even, odd);
+    _mm256_storeu_ps(mat4_out, _mm256_permute2f128_ps(rows02, rows13, 0x20));
+    _mm256_storeu_ps(mat4_out + 8, _mm256_permute2f128_ps(rows02, rows13, 0x31));
+}
 
-    // Transform Screen Vector into Gobal Coordinates and Add to Camera and Center Position
-    if(delta_x == 0 && delta_y == 0){return;}
-    else{
-        // Create Local Vector
-        float vec[2] = {-delta_x*radius*pixel_to_wspace_x, delta_y*radius*pixel_to_wspace_y};
 
-        // Multiply Vector by the Basis Matrix Transposed
-        for (int i = 0; i < 3; i++){
-            float temp = basis[i]*vec[0] + basis[i + 3]*vec[1];
-            camera_pos[i] += temp;
-            center_pos[i] += temp;
-        }
-    }
+// Whole Matrix in One 512 Bit Register
+__attribute__((target("avx512f")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TAVX512(const float * __restrict__ mat4_1, 
+const float * __restrict__ mat4_2, float * __restrict__ out){
+    const __m512i transpose = _mm512_set_epi32(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0);
+    __m512 cols = _mm512_permutexvar_ps(transpose, _mm512_loadu_ps(mat4_2));
+    __m512 rows = _mm512_loadu_ps(mat4_1);
+
+    __m512 sum = _mm512_mul_ps(_mm512_permute_ps(rows, 0x00), _mm512_shuffle_f32x4(cols, cols, 0x00));
+    sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0x55), _mm512_shuffle_f32x4(cols, cols, 0x55)));
+    sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0xAA), _mm512_shuffle_f32x4(cols, cols, 0xAA)));
+    sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0xFF), _mm512_shuffle_f32x4(cols, cols, 0xFF)));
+    _mm512_storeu_ps(out, sum);
 }
 
 
-void Zoom(const float mouse_x, const float mouse_y, const float zoom){
+__attribute__((target("avx512f")))
+void TransposeMat4AVX512(const float *__restrict__ mat4_in, float *__restrict__ mat4_out){
+    const __m512i transpose = _mm512_set_epi32(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0);
+    _mm512_storeu_ps(mat4_out, _mm512_permutexvar_ps(transpose, _mm512_loadu_ps(mat4_in)));
+}
 
-    // translate center and camera_pos to new mouse coordinates
-    if(zoom < 0){
-        float vec[2] = {-zoom_translate_sensitivity*mouse_x*radius*pixel_to_wspace_x, zoom_translate_sensitivity*mouse_y*radius*pixel_to_wspace_y};
+#endif
 
-        // Multiply Vector by the Basis Matrix Transposed
-        for (int i = 0; i < 3; i++){
-            float temp = basis[i]*vec[0] + basis[i + 3]*vec[1];
-            camera_pos[i] += temp;
-            center_pos[i] += temp;
-        }
-    }
 
+typedef void (*mat4_multiply_kernel)(const float * __restrict__, const float * __restrict__, float * __restrict__);
 
-    radius += zoom_sensitivity*zoom;
+typedef void (*mat4_transpose_kernel)(const float * __restrict__, float * __restrict__);
 
-    if(radius < 0){
-        radius = .001;
+
+// Kernel for a Given Level, Falls Back to Scalar Where no Explicit Kernel Exists
+mat4_multiply_kernel Mat4MultiplyMat4TKernel(const simd_level level){
+#ifdef AGP_X86
+    switch(level){
+        case simd_avx512: return Mat4MultiplyMat4TAVX512;
+        case simd_avx2: return Mat4MultiplyMat4TAVX2;
+        case simd_sse2: return Mat4MultiplyMat4TSSE2;
+        default: break;
     }
+#endif
+    return Mat4MultiplyMat4TScalar;
+}
 
-    float dir_vec[3];
-    DiffVec<3>(camera_pos, center_pos, dir_vec);
-    NormalizeVec<3>(dir_vec);
-    for (int i=0; i<3; i++){
-        camera_pos[i] = dir_vec[i]*radius + center_pos[i];
+
+mat4_transpose_kernel TransposeMat4Kernel(const simd_level level){
+#ifdef AGP_X86
+    switch(level){
+        case simd_avx512: return TransposeMat4AVX512;
+        case simd_avx2: return TransposeMat4AVX2;
+        case simd_sse2: return TransposeMat4SSE2;
+        default: break;
     }
+#endif
+    return TransposeMat4Scalar;
+}
 
 
+// result = matrix_1 * matrix_2 in row major order
+void Mat4MultiplyMat4T(const float * __restrict__ mat4_1, 
+const float * __restrict__ mat4_2, float * __restrict__ out){
+    AGP_TRACE_SCOPE("Mat4MultiplyMat4T");
+    static const mat4_multiply_kernel kernel = Mat4MultiplyMat4TKernel(SimdLevel());
+    kernel(mat4_1, mat4_2, out);
 }
 
 
-void Rotate(const float delta_x, const float delta_y){
+void TransposeMat4(float *__restrict__ mat4_in, float *__restrict__ mat4_out){
+    AGP_TRACE_SCOPE("TransposeMat4");
+    static const mat4_transpose_kernel kernel = TransposeMat4Kernel(SimdLevel());
+    kernel(mat4_in, mat4_out);
+}
 
-    if(delta_x == 0 && delta_y == 0){return;}
-    else{
-        // Calculate local position vector
-        float magnitude = sqrt(delta_x*delta_x + delta_y*delta_y);
-        float theta = rotate_sensitivity*magnitude;
+
+// Outputs at Least This Many Bytes are Written With Non-Temporal Stores
+// (When Aligned) so the Results Don't Evict the Models From Cache
+const size_t mat4_stream_threshold = 1 << 20;
+
+
+// out[i] = models[i] * matrix_2 for count Matrices. Strides are in Floats
+// Between the Starts of Consecutive Matrices
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TBatchScalar(const float * __restrict__ models, const size_t model_stride,
+const float * __restrict__ mat4_2, float * __restrict__ out, const size_t out_stride,
+const size_t count, const bool /*is_streamed*/){
+    for(size_t i=0; i<count; i++){
+        Mat4MultiplyMat4TScalar(models + i*model_stride, mat4_2, out + i*out_stride);
+    }
+}
+
+
+#ifdef AGP_X86
+
+__attribute__((target("sse2")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TBatchSSE2(const float * __restrict__ models, const size_t model_stride,
+const float * __restrict__ mat4_2, float * __restrict__ out, const size_t out_stride,
+const size_t count, const bool is_streamed){
+    // Columns of matrix_2 Stay in Registers for the Whole Batch
+    __m128 col0 = _mm_loadu_ps(mat4_2);
+    __m128 col1 = _mm_loadu_ps(mat4_2 + 4);
+    __m128 col2 = _mm_loadu_ps(mat4_2 + 8);
+    __m128 col3 = _mm_loadu_ps(mat4_2 + 12);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    for(size_t n=0; n<count; n++){
+        const float *model = models + n*model_stride;
+        float *result = out + n*out_stride;
+        for(int i=0; i<4; i++){
+            __m128 row = _mm_loadu_ps(model + i*4);
+            __m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), col0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), col1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), col2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), col3));
+            if(is_streamed){_mm_stream_ps(result + i*4, sum);}
+            else{_mm_storeu_ps(result + i*4, sum);}
+        }
+    }
+    if(is_streamed){_mm_sfence();}
+}
+
+
+__attribute__((target("avx2")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TBatchAVX2(const float * __restrict__ models, const size_t model_stride,
+const float * __restrict__ mat4_2, float * __restrict__ out, const size_t out_stride,
+const size_t count, const bool is_streamed){
+    __m128 col0 = _mm_loadu_ps(mat4_2);
+    __m128 col1 = _mm_loadu_ps(mat4_2 + 4);
+    __m128 col2 = _mm_loadu_ps(mat4_2 + 8);
+    __m128 col3 = _mm_loadu_ps(mat4_2 + 12);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+    __m256 cols0 = _mm256_insertf128_ps(_mm256_castps128_ps256(col0), col0, 1);
+    __m256 cols1 = _mm256_insertf128_ps(_mm256_castps128_ps256(col1), col1, 1);
+    __m256 cols2 = _mm256_insertf128_ps(_mm256_castps128_ps256(col2), col2, 1);
+    __m256 cols3 = _mm256_insertf128_ps(_mm256_castps128_ps256(col3), col3, 1);
+
+    for(size_t n=0; n<count; n++){
+        const float *model = models + n*model_stride;
+        float *result = out + n*out_stride;
+        for(int i=0; i<4; i+=2){
+            __m256 rows = _mm256_loadu_ps(model + i*4);
+            __m256 sum = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), cols0);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0x55), cols1));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0xAA), cols2));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(rows, 0xFF), cols3));
+            if(is_streamed){_mm256_stream_ps(result + i*4, sum);}
+            else{_mm256_storeu_ps(result + i*4, sum);}
+        }
+    }
+    if(is_streamed){_mm_sfence();}
+}
+
+
+__attribute__((target("avx512f")))
+AGP_NO_FP_CONTRACT
+void Mat4MultiplyMat4TBatchAVX512(const float * __restrict__ models, const size_t model_stride,
+const float * __restrict__ mat4_2, float * __restrict__ out, const size_t out_stride,
+const size_t count, const bool is_streamed){
+    const __m512i transpose = _mm512_set_epi32(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0);
+    __m512 cols = _mm512_permutexvar_ps(transpose, _mm512_loadu_ps(mat4_2));
+    __m512 cols0 = _mm512_shuffle_f32x4(cols, cols, 0x00);
+    __m512 cols1 = _mm512_shuffle_f32x4(cols, cols, 0x55);
+    __m512 cols2 = _mm512_shuffle_f32x4(cols, cols, 0xAA);
+    __m512 cols3 = _mm512_shuffle_f32x4(cols, cols, 0xFF);
+
+    for(size_t n=0; n<count; n++){
+        __m512 rows = _mm512_loadu_ps(models + n*model_stride);
+        __m512 sum = _mm512_mul_ps(_mm512_permute_ps(rows, 0x00), cols0);
+        sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0x55), cols1));
+        sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0xAA), cols2));
+        sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_permute_ps(rows, 0xFF), cols3));
+        if(is_streamed){_mm512_stream_ps(out + n*out_stride, sum);}
+        else{_mm512_storeu_ps(out + n*out_stride, sum);}
+    }
+    if(is_streamed){_mm_sfence();}
+}
+
+#endif
+
+
+typedef void (*mat4_batch_kernel)(const float * __restrict__, const size_t, const float * __restrict__,
+float * __restrict__, const size_t, const size_t, const bool);
+
+
+mat4_batch_kernel Mat4MultiplyMat4TBatchKernel(const simd_level level){
+#ifdef AGP_X86
+    switch(level){
+        case simd_avx512: return Mat4MultiplyMat4TBatchAVX512;
+        case simd_avx2: return Mat4MultiplyMat4TBatchAVX2;
+        case simd_sse2: return Mat4MultiplyMat4TBatchSSE2;
+        default: break;
+    }
+#endif
+    return Mat4MultiplyMat4TBatchScalar;
+}
+
+
+// Byte Alignment Each Level's Non-Temporal Stores Need
+size_t SimdAlignment(const simd_level level){
+    switch(level){
+        case simd_avx512: return 64;
+        case simd_avx2: return 32;
+        case simd_sse2: return 16;
+        default: return 1;
+    }
+}
+
+// Floats per Register at Each Level
+size_t SimdFloatWidth(const simd_level level){
+    switch(level){
+        case simd_avx512: return 16;
+        case simd_avx2: return 8;
+        case simd_sse2: return 4;
+        default: return 1;
+    }
+}
+
+
+// Whether a Batch of count Matrices Written to out Uses Non-Temporal Stores
+bool IsMat4BatchStreamed(const float *out, const size_t out_stride, const size_t count){
+    static const simd_level level = SimdLevel();
+    size_t alignment = SimdAlignment(level);
+    bool is_aligned = (uintptr_t)out % alignment == 0 && (out_stride*sizeof(float)) % alignment == 0;
+    return level != simd_scalar && is_aligned && count*16*sizeof(float) >= mat4_stream_threshold;
+}
+
+
+// out[i] = models[i] * matrix_2 for count Matrices, e.g. Every Model
+// Matrix Times the Output of arcball::ViewProjMatrix(). Strides are in
+// Floats and Must be at Least 16
+void Mat4MultiplyMat4TBatch(const float * __restrict__ models, const float * __restrict__ mat4_2,
+float * __restrict__ out, const size_t count, const size_t model_stride = 16, const size_t out_stride = 16){
+    AGP_TRACE_SCOPE("Mat4MultiplyMat4TBatch");
+    static const mat4_batch_kernel kernel = Mat4MultiplyMat4TBatchKernel(SimdLevel());
+    kernel(models, model_stride, mat4_2, out, out_stride, count, IsMat4BatchStreamed(out, out_stride, count));
+}
+
+
+// Memory Order of the Matrices Written by the Output Overloads Below.
+// row_major Matches Every Other Output, column_major is What OpenGL Takes
+enum matrix_layout { row_major, column_major };
+
+
+// Writes the Row Major 4x4 matrix to out in layout. When is_streamed and
+// out is 16 Byte Aligned it Uses Non-Temporal Stores, Which Write Combined
+// Memory Such as a Persistently Mapped GPU Buffer Takes a Whole Line at a
+// Time, Otherwise Ordinary Stores. Call StoreFence() After the Last Store
+void StoreMat4(const float *matrix, float *out, const matrix_layout layout, const bool is_streamed){
+#if defined(AGP_X86) && defined(__SSE__)
+    __m128 row0 = _mm_loadu_ps(matrix);
+    __m128 row1 = _mm_loadu_ps(matrix + 4);
+    __m128 row2 = _mm_loadu_ps(matrix + 8);
+    __m128 row3 = _mm_loadu_ps(matrix + 12);
+    if(layout == column_major){_MM_TRANSPOSE4_PS(row0, row1, row2, row3);}
+    if(is_streamed && (uintptr_t)out % 16 == 0){
+        _mm_stream_ps(out, row0);
+        _mm_stream_ps(out + 4, row1);
+        _mm_stream_ps(out + 8, row2);
+        _mm_stream_ps(out + 12, row3);
+    }
+    else{
+        _mm_storeu_ps(out, row0);
+        _mm_storeu_ps(out + 4, row1);
+        _mm_storeu_ps(out + 8, row2);
+        _mm_storeu_ps(out + 12, row3);
+    }
+#else
+    if(layout == column_major){TransposeMat4Scalar(matrix, out);}
+    else{std::copy(matrix, matrix + 16, out);}
+#endif
+}
+
+// Double Matrices are Always Written With Ordinary Stores
+void StoreMat4(const double *matrix, double *out, const matrix_layout layout, const bool /*is_streamed*/){
+    for(int i=0; i<4; i++){
+        for(int j=0; j<4; j++){
+            out[i*4 + j] = layout == column_major ? matrix[j*4 + i] : matrix[i*4 + j];
+        }
+    }
+}
+
+
+// Orders Earlier Non-Temporal Stores Before Anything Written After, e.g.
+// the Fence or Flag Telling the GPU a Mapped Buffer is Ready
+void StoreFence(){
+#if defined(AGP_X86) && defined(__SSE__)
+    _mm_sfence();
+#endif
+}
+
+
+void PrintMat4(const float *matrix, const char* name){
+    std::cout<<name<<" = { ";
+    int spaces = sizeof(name)/sizeof(name[0]);
+    int dim = 4; // Can Make for Arbitrary Square Dim
+    for(int i=0;i<dim;i++){
+        for(int j=0;j<dim - 1;j++){
+            std::cout<<std::to_string(matrix[i*dim + j])<<", ";
+        }
+        std::cout<<std::to_string(matrix[i*dim + dim - 1]);
+        if(i < dim - 1){
+            std::cout<<", \n";
+            for(int j=0;j<spaces;j++){
+                std::cout<<" ";
+            }
+        }
+    }
+    std::cout<<" }\n";
+}
+
+// Math Policies, Picked at Compile Time by the Functions That Take a Math
+// Template Parameter, e.g. arc.Rotate<math_fast>(dx, dy). Each Gives
+// Sqrt, RSqrt (1/sqrt), Sin and Cos, and Their Maximum Error:
+//   RSqrtError() Relative Error of RSqrt and Sqrt
+//   TrigError()  Absolute Error of Sin and Cos for |x| <= TrigRange()
+
+// The std Functions, Correctly Rounded or Close to it
+struct math_precise{
+
+template<typename T> static T Sqrt(const T x){return sqrt(x);}
+
+template<typename T> static T RSqrt(const T x){return 1/sqrt(x);}
+
+template<typename T> static T Sin(const T x){return sin(x);}
+
+template<typename T> static T Cos(const T x){return cos(x);}
+
+static constexpr double RSqrtError(){return 1e-7;}
+
+static constexpr double TrigError(){return 1e-7;}
+
+static constexpr double TrigRange(){return 1e6;}
+
+};
+
+
+// 1/sqrt(x) to About 3.5%, From the Bits of x
+float RSqrtEstimate(const float x){
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(float));
+    bits = 0x5f375a86 - (bits >> 1);
+    float estimate;
+    memcpy(&estimate, &bits, sizeof(float));
+    return estimate;
+}
+
+
+// Hardware Reciprocal Square Root Estimate Plus One Newton Step, and
+// Minimax sin/cos Polynomials on [-pi/4, pi/4] After Reduction by pi/2.
+// Angles Below 2^-12 Skip the Polynomial. Accurate to Roughly float
+// Precision, Also When T is double
+struct math_fast{
+
+template<typename T> static T Sqrt(const T x){
+    return x > 0 ? x*RSqrt(x) : 0;
+}
+
+template<typename T> static T RSqrt(const T x){
+#if defined(AGP_X86) && defined(__SSE__)
+    T estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss((float)x)));
+#else
+    T estimate = RSqrtEstimate((float)x);
+#endif
+    return estimate*((T)1.5 - (T)0.5*x*estimate*estimate);
+}
+
+template<typename T> static T Sin(const T x){
+    if(x < (T)0.000244140625 && x > -(T)0.000244140625){return x;}
+    int quadrant;
+    T r = Reduce(x, quadrant);
+    T value = (quadrant & 1) ? CosPolynomial(r) : SinPolynomial(r);
+    return (quadrant & 2) ? -value : value;
+}
+
+template<typename T> static T Cos(const T x){
+    if(x < (T)0.000244140625 && x > -(T)0.000244140625){return 1 - (T)0.5*x*x;}
+    int quadrant;
+    T r = Reduce(x, quadrant);
+    T value = (quadrant & 1) ? SinPolynomial(r) : CosPolynomial(r);
+    return ((quadrant + 1) & 2) ? -value : value;
+}
+
+static constexpr double RSqrtError(){return 3e-7;}
+
+static constexpr double TrigError(){return 2e-7;}
+
+static constexpr double TrigRange(){return 1e4;}
+
+// Branchless Versions for Batch Kernels, so Loops Calling Them Vectorize.
+// SinCos Has the Same Error as Sin and Cos Without the Small Angle Shortcut.
+// Atan2 is Within 3e-7 of atan2 for float (Also double, Limited by the
+// Coefficients), but Returns 0 for atan2(0, -0) Where atan2 Returns pi
+template<typename T> static void SinCos(const T x, T &sine, T &cosine){
+    int quadrant;
+    T r = Reduce(x, quadrant);
+    T s = SinPolynomial(r);
+    T c = CosPolynomial(r);
+    T sin_value = (quadrant & 1) ? c : s;
+    T cos_value = (quadrant & 1) ? s : c;
+    sine = (quadrant & 2) ? -sin_value : sin_value;
+    cosine = ((quadrant + 1) & 2) ? -cos_value : cos_value;
+}
+
+template<typename T> static T Atan2(const T y, const T x){
+    T abs_x = x < 0 ? -x : x;
+    T abs_y = y < 0 ? -y : y;
+    T high = abs_x > abs_y ? abs_x : abs_y;
+    T low = abs_x > abs_y ? abs_y : abs_x;
+    T ratio = high > 0 ? low/high : 0;
+
+    // atan(ratio) = pi/4 + atan((ratio - 1)/(ratio + 1)) Above tan(pi/8)
+    bool is_upper = ratio > (T)0.414213562373095;
+    T u = is_upper ? (ratio - 1)/(ratio + 1) : ratio;
+    T z = u*u;
+    T angle = ((((T)8.05374449538e-2*z - (T)1.38776856032e-1)*z + (T)1.99777106478e-1)*z
+        - (T)3.33329491539e-1)*z*u + u;
+    angle = is_upper ? angle + (T)0.785398163397448310 : angle;
+    angle = abs_y > abs_x ? (T)1.57079632679489662 - angle : angle;
+    angle = x < 0 ? (T)3.14159265358979324 - angle : angle;
+    return y < 0 ? -angle : angle;
+}
+
+// x = quadrant*pi/2 + r, |r| <= pi/4. pi/2 is Split Into Three Parts so
+// the Products are Exact for Small Quadrant Counts (Cody-Waite)
+template<typename T> static T Reduce(const T x, int &quadrant){
+    T turns = x*(T)0.636619772367581343;
+    int k = (int)(turns + (turns >= 0 ? (T)0.5 : -(T)0.5));
+    quadrant = k & 3;
+    T k_t = (T)k;
+    return ((x - k_t*(T)1.5703125) - k_t*(T)4.837512969970703125e-4) - k_t*(T)7.54978995489188216e-8;
+}
+
+
+private:
+
+template<typename T> static T SinPolynomial(const T r){
+    T r2 = r*r;
+    return r + r*r2*((T)-1.6666654611e-1 + r2*((T)8.3321608736e-3 + r2*(T)-1.9515295891e-4));
+}
+
+template<typename T> static T CosPolynomial(const T r){
+    T r2 = r*r;
+    return 1 - (T)0.5*r2 + r2*r2*((T)4.166664568298827e-2 + r2*((T)-1.388731625493765e-3 + r2*(T)2.443315711809948e-5));
+}
+
+};
+
+
+// Bit Trick Reciprocal Square Root With One Newton Step, and Shorter sin/cos
+// Series. Angles Below 0.5, the Usual Case for Per Event Rotations, Skip the
+// Range Reduction
+struct math_approximate{
+
+template<typename T> static T Sqrt(const T x){
+    return x > 0 ? x*RSqrt(x) : 0;
+}
+
+template<typename T> static T RSqrt(const T x){
+    T estimate = RSqrtEstimate((float)x);
+    return estimate*((T)1.5 - (T)0.5*x*estimate*estimate);
+}
+
+template<typename T> static T Sin(const T x){
+    if(x < (T)0.5 && x > -(T)0.5){return SinSeries(x);}
+    int quadrant;
+    T r = math_fast::Reduce(x, quadrant);
+    T value = (quadrant & 1) ? CosSeries(r) : SinSeries(r);
+    return (quadrant & 2) ? -value : value;
+}
+
+template<typename T> static T Cos(const T x){
+    if(x < (T)0.5 && x > -(T)0.5){return CosSeries(x);}
+    int quadrant;
+    T r = math_fast::Reduce(x, quadrant);
+    T value = (quadrant & 1) ? SinSeries(r) : CosSeries(r);
+    return ((quadrant + 1) & 2) ? -value : value;
+}
+
+static constexpr double RSqrtError(){return 2e-3;}
+
+static constexpr double TrigError(){return 4e-5;}
+
+static constexpr double TrigRange(){return 1e4;}
+
+
+private:
+
+// Taylor Series Through x^5 and x^6
+template<typename T> static T SinSeries(const T x){
+    T x2 = x*x;
+    return x - x*x2*(T)(1.0/6)*(1 - x2*(T)(1.0/20));
+}
+
+template<typename T> static T CosSeries(const T x){
+    T x2 = x*x;
+    return 1 - (T)0.5*x2*(1 - x2*(T)(1.0/12)*(1 - x2*(T)(1.0/30)));
+}
+
+};
+
+
+template<int N, typename Math = math_precise>
+void NormalizeVec(float *vec3){
+    float magnitude = 0;
+    for(int i=0; i<N; i++){
+        magnitude += vec3[i]*vec3[i];
+    }
+    magnitude = Math::RSqrt(magnitude);
+
+    for(int i=0; i<N; i++){
+        vec3[i] = vec3[i]*magnitude;
+    }
+}
+
+
+void CrossVec(const float * __restrict__ left_vec, 
+const float * __restrict__ right_vec, float * __restrict__ return_vec){
+    return_vec[0] = left_vec[1]*right_vec[2] - left_vec[2]*right_vec[1];
+    return_vec[1] = left_vec[2]*right_vec[0] - left_vec[0]*right_vec[2];
+    return_vec[2] = left_vec[0]*right_vec[1] - left_vec[1]*right_vec[0];
+}
+
+template<int N>
+float DotVec(const float * __restrict__ vec1, const float * __restrict__ vec2){
+    float output = 0;
+    for (int i=0; i<N; i++){
+        output += vec1[i]*vec2[i];
+    }
+    return output;
+}
+
+
+// outvec = vec1 - vec2
+template<int N>
+void DiffVec(const float * __restrict__ vec1, const float * __restrict__ vec2,
+ float * __restrict__ outvec){
+    for (int i=0; i<N; i++){
+        outvec[i] = vec1[i] - vec2[i];
+    }
+}
+
+
+template<int N>
+float MagnitudeVec(const float *vec){
+    float output = 0;
+    for (int i=0; i<N; i++){
+        output += vec[i]*vec[i];
+    }
+    return sqrt(output);
+}
+
+
+// Compile Time Math. C++11 constexpr Versions of sqrt, sin, cos and tan,
+// Evaluated in double so the Results are Exact to float Precision. They
+// Recurse, so Prefer the std Functions for Values Only Known at Run Time
+constexpr double const_pi = 3.14159265358979323846;
+
+constexpr double ConstSqrtNewton(const double x, const double guess, const double previous, const int steps){
+    return (guess == previous || steps == 0) ? guess :
+        ConstSqrtNewton(x, 0.5*(guess + x/guess), guess, steps - 1);
+}
+
+// Scales x by Powers of 2^64 Into [2^-64, 2^64] so Newton Converges in Few Steps
+constexpr double ConstSqrtScaled(const double x, const double factor){
+    return x > 18446744073709551616.0 ? ConstSqrtScaled(x/18446744073709551616.0, factor*4294967296.0) :
+        x < 1/18446744073709551616.0 ? ConstSqrtScaled(x*18446744073709551616.0, factor/4294967296.0) :
+        factor*ConstSqrtNewton(x, x > 1 ? x : 1, 0, 100);
+}
+
+constexpr double ConstSqrt(const double x){
+    return x == 0 ? 0 :
+        (x > 0 && x < std::numeric_limits<double>::infinity()) ? ConstSqrtScaled(x, 1) :
+        x == std::numeric_limits<double>::infinity() ? x : std::numeric_limits<double>::quiet_NaN();
+}
+
+// Wraps to [-pi, pi]
+constexpr double ConstWrapAngle(const double x){
+    return x - 2*const_pi*(double)(long long)(x/(2*const_pi) + (x >= 0 ? 0.5 : -0.5));
+}
+
+// Taylor Series, sum + term*(1 - x2/((n + 1)(n + 2)) + ...)
+constexpr double ConstTaylor(const double x2, const double term, const double sum, const int n){
+    return n > 40 ? sum : ConstTaylor(x2, -term*x2/((n + 1)*(n + 2)), sum + term, n + 2);
+}
+
+constexpr double ConstSin(const double x){
+    return ConstTaylor(ConstWrapAngle(x)*ConstWrapAngle(x), ConstWrapAngle(x), 0, 1);
+}
+
+constexpr double ConstCos(const double x){
+    return ConstTaylor(ConstWrapAngle(x)*ConstWrapAngle(x), 1, 0, 0);
+}
+
+constexpr double ConstTan(const double x){
+    return ConstSin(x)/ConstCos(x);
+}
+
+
+// Literal 3 Vector for Compile Time Constants. data Can be Passed Straight
+// to the Pointer Based Functions, e.g. arc.SetCamera(eye.data, up.data)
+struct vec3{
+    float data[3];
+
+    constexpr float operator[] (const int pos) const {return data[pos];}
+};
+
+constexpr float DotVec(const vec3 &vec1, const vec3 &vec2){
+    return vec1[0]*vec2[0] + vec1[1]*vec2[1] + vec1[2]*vec2[2];
+}
+
+constexpr vec3 CrossVec(const vec3 &left_vec, const vec3 &right_vec){
+    return vec3{{left_vec[1]*right_vec[2] - left_vec[2]*right_vec[1],
+                 left_vec[2]*right_vec[0] - left_vec[0]*right_vec[2],
+                 left_vec[0]*right_vec[1] - left_vec[1]*right_vec[0]}};
+}
+
+// vec1 - vec2
+constexpr vec3 DiffVec(const vec3 &vec1, const vec3 &vec2){
+    return vec3{{vec1[0] - vec2[0], vec1[1] - vec2[1], vec1[2] - vec2[2]}};
+}
+
+constexpr float MagnitudeVec(const vec3 &vec){
+    return (float)ConstSqrt(DotVec(vec, vec));
+}
+
+constexpr vec3 ScaleVec(const vec3 &vec, const float scale){
+    return vec3{{vec[0]*scale, vec[1]*scale, vec[2]*scale}};
+}
+
+constexpr vec3 NormalizeVec(const vec3 &vec){
+    return ScaleVec(vec, (float)(1/ConstSqrt(DotVec(vec, vec))));
+}
+
+
+// Perspective Projection Matrix Values, Laid Out as in arcball::ViewProjMatrix()
+struct projection_matrix{
+    float m00;
+    float m11;
+    float m22;
+    float m32;
+};
+
+// fov is the Vertical Field of View in Radians
+constexpr projection_matrix PerspectiveProjection(const double fov, const double aspect_ratio,
+const double z_near, const double z_far){
+    return projection_matrix{(float)(1/(aspect_ratio*ConstTan(0.5*fov))), (float)(1/ConstTan(0.5*fov)),
+        (float)((z_near + z_far)/(z_near - z_far)), (float)(2*z_near*z_far/(z_near - z_far))};
+}
+
+// arcball's Projection Before SetProjectionVars() or SetProjection() is Called
+constexpr projection_matrix default_projection = PerspectiveProjection(40*3.14/180, 1, 0.1, 100);
+
+
+// Exact Inverse of the View Projection Matrix Built From basis (Right, Up
+// and Back Rows), camera_pos and projection, Written Row Major to matrix.
+// Uses the Sparse Structure Instead of a General 4x4 Inversion: the
+// Projection Inverts in Closed Form and the Basis Through its Adjugate,
+// so it Holds Even When the Up Row Isn't Perpendicular to the Back Row
+void InverseViewProjMatrix(const float *basis, const float *camera_pos, const projection_matrix &projection,
+float *matrix){
+    // Columns of the Basis Inverse
+    float inverse[3][3];
+    CrossVec(basis + 3, basis + 6, inverse[0]);
+    CrossVec(basis + 6, basis, inverse[1]);
+    CrossVec(basis, basis + 3, inverse[2]);
+    float determinant = DotVec<3>(basis, inverse[0]);
+
+    float scale[3] = {1/(determinant*projection.m00), 1/(determinant*projection.m11), 1/determinant};
+    for(int i=0; i<3; i++){
+        matrix[4*i] = inverse[0][i]*scale[0];
+        matrix[4*i + 1] = inverse[1][i]*scale[1];
+        matrix[4*i + 2] = camera_pos[i]/projection.m32;
+        matrix[4*i + 3] = -inverse[2][i]*scale[2] + camera_pos[i]*projection.m22/projection.m32;
+    }
+    matrix[12] = 0;
+    matrix[13] = 0;
+    matrix[14] = 1/projection.m32;
+    matrix[15] = projection.m22/projection.m32;
+}
+
+
+// Persistent Worker Threads Shared by the Parallel Kernels. The Calling
+// Thread Works Alongside the Workers, and a ParallelFor Issued While the
+// Pool is Already Busy (e.g. From Inside a Job) Runs Serially Instead.
+// Each Thread Starts on its Own Contiguous Run of Chunks, so it Walks
+// Memory in Order and Gets the Same Part of a Same Sized Job Every Frame,
+// and Once its Run is Empty Steals the Back Half of Another Thread's
+class thread_pool{
+
+public:
+
+// Constructors
+explicit thread_pool(unsigned thread_count = std::thread::hardware_concurrency())
+: ranges(std::max(thread_count, 1u)){
+    for(unsigned i=1; i<thread_count; i++){
+        workers.push_back(std::thread(Run, this, i));
+    }
+};
+
+
+// Destructor
+~thread_pool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopping = true;
+    }
+    wake.notify_all();
+    for(size_t i=0; i<workers.size(); i++){
+        workers[i].join();
+    }
+};
+
+
+// Member Functions
+
+// Number of Threads Including the Caller
+unsigned Size() const {return workers.size() + 1;}
+
+// Calls function(begin, end) Over [0, count) in Pieces of chunk_size,
+// Returns Once Every Piece is Done. Pieces Always Start on a Multiple of
+// chunk_size. If a Piece Throws, Pieces Not Yet Started are Skipped and
+// the First Exception is Rethrown Once Every Thread has Stopped
+template<typename F>
+void ParallelFor(const size_t count, size_t chunk_size, F &function){
+    if(count == 0){return;}
+    if(workers.empty() || count <= chunk_size || is_busy.exchange(true)){
+        function((size_t)0, count);
+        return;
+    }
+
+    // Chunk Indices are Packed Two to a Word
+    chunk_size = std::max(chunk_size, (count - 1)/0xFFFFFFFF + 1);
+    size_t chunk_count = (count + chunk_size - 1)/chunk_size;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = Call<F>;
+        job_context = &function;
+        job_count = count;
+        job_chunk_size = chunk_size;
+        is_failed.store(false);
+        for(size_t i=0; i<ranges.size(); i++){
+            ranges[i].chunks.store(PackRange(chunk_count*i/ranges.size(), chunk_count*(i + 1)/ranges.size()));
+        }
+        active_workers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    Work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]{return active_workers == 0;});
+    job = 0;
+#ifdef AGP_EXCEPTIONS
+    std::exception_ptr job_error = error;
+    error = nullptr;
+    is_busy.store(false);
+    if(job_error){std::rethrow_exception(job_error);}
+#else
+    is_busy.store(false);
+#endif
+}
+
+
+private:
+
+// Chunks [begin, end) Waiting to Run on One Thread, Padded so Threads
+// Don't Share Cache Lines
+struct chunk_range{
+    std::atomic<uint64_t> chunks{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+static uint64_t PackRange(const uint64_t begin, const uint64_t end){return begin << 32 | end;}
+
+template<typename F>
+static void Call(void *function, const size_t begin, const size_t end){
+    (*static_cast<F*>(function))(begin, end);
+}
+
+// Runs Chunks From the Front of this Thread's Range, Then Steals Until
+// Every Range is Empty
+void Work(const size_t thread_index){
+    std::atomic<uint64_t> &own = ranges[thread_index].chunks;
+    for(;;){
+        uint64_t range = own.load();
+        while((range >> 32) < (range & 0xFFFFFFFF)){
+            if(own.compare_exchange_weak(range, range + ((uint64_t)1 << 32))){
+                RunChunk((range >> 32)*job_chunk_size);
+                range = own.load();
+            }
+        }
+        if(!Steal(thread_index)){return;}
+    }
+}
+
+// Once a Chunk Throws the Rest are Skipped, the First Exception is Kept
+// for ParallelFor to Rethrow
+void RunChunk(const size_t begin){
+    if(is_failed.load()){return;}
+#ifdef AGP_EXCEPTIONS
+    try{
+        job(job_context, begin, std::min(begin + job_chunk_size, job_count));
+    }
+    catch(...){
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!error){error = std::current_exception();}
+        is_failed.store(true);
+    }
+#else
+    job(job_context, begin, std::min(begin + job_chunk_size, job_count));
+#endif
+}
+
+// Moves the Back Half of the First Non-Empty Range Found Into this
+// Thread's Range. Only the Owner Refills its Range, and Only Once it's
+// Empty, so Thieves Never See a Range Grow Under Them
+bool Steal(const size_t thread_index){
+    for(size_t i=1; i<ranges.size(); i++){
+        std::atomic<uint64_t> &victim = ranges[(thread_index + i) % ranges.size()].chunks;
+        uint64_t range = victim.load();
+        for(;;){
+            uint64_t begin = range >> 32;
+            uint64_t end = range & 0xFFFFFFFF;
+            if(begin >= end){break;}
+            uint64_t split = end - (end - begin + 1)/2;
+            if(victim.compare_exchange_weak(range, PackRange(begin, split))){
+                ranges[thread_index].chunks.store(PackRange(split, end));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void Run(thread_pool *pool, const size_t thread_index){
+    size_t seen_generation = 0;
+    for(;;){
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->wake.wait(lock, [&]{return pool->is_stopping || pool->generation != seen_generation;});
+            if(pool->is_stopping){return;}
+            seen_generation = pool->generation;
+        }
+
+        pool->Work(thread_index);
+
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if(--pool->active_workers == 0){pool->done.notify_one();}
+    }
+}
+
+std::vector<std::thread> workers;
+
+std::mutex mutex;
+
+std::condition_variable wake;
+
+std::condition_variable done;
+
+std::atomic<bool> is_busy{false};
+
+// Set When a Chunk of the Current Job Throws
+std::atomic<bool> is_failed{false};
+
+#ifdef AGP_EXCEPTIONS
+std::exception_ptr error;
+#endif
+
+bool is_stopping = false;
+
+size_t generation = 0;
+
+size_t active_workers = 0;
+
+// Current Job
+void (*job)(void*, size_t, size_t) = 0;
+
+void *job_context = 0;
+
+size_t job_count = 0;
+
+size_t job_chunk_size = 1;
+
+// One per Thread, Index 0 is the Caller's
+std::vector<chunk_range> ranges;
+
+};
+
+
+// Pool Used When a Parallel Kernel isn't Given One
+thread_pool &DefaultThreadPool(){
+    static thread_pool pool;
+    return pool;
+}
+
+
+// Pixels per Thread Pool Chunk When Generating Rays
+const size_t ray_chunk_size = 16384;
+
+// Most Points DepthPoints() Hands its Sink at Once
+const size_t depth_tile_size = 4096;
+
+// Pixels Reconstructed at a Time Before Far Plane Pixels are Dropped
+const size_t depth_block_size = 256;
+
+// Matrices per Thread Pool Chunk in the Batch Matrix Kernels, 64 KB of
+// Input Plus 64 KB of Output so a Chunk Stays in L2
+const size_t mat4_chunk_size = 1024;
+
+
+// Same as Mat4MultiplyMat4TBatch() Split Across pool. Whether to Stream is
+// Decided Once for the Whole Batch so Every Chunk Stores the Same Way
+void Mat4MultiplyMat4TBatch(const float * __restrict__ models, const float * __restrict__ mat4_2,
+float * __restrict__ out, const size_t count, thread_pool &pool,
+const size_t model_stride = 16, const size_t out_stride = 16){
+    AGP_TRACE_SCOPE("Mat4MultiplyMat4TBatch");
+    static const mat4_batch_kernel kernel = Mat4MultiplyMat4TBatchKernel(SimdLevel());
+    struct multiply_job{
+        const float *models;
+        const float *mat4_2;
+        float *out;
+        size_t model_stride;
+        size_t out_stride;
+        bool is_streamed;
+        void operator()(const size_t begin, const size_t end){
+            kernel(models + begin*model_stride, model_stride, mat4_2, out + begin*out_stride, out_stride,
+                end - begin, is_streamed);
+        }
+    } job = {models, mat4_2, out, model_stride, out_stride, IsMat4BatchStreamed(out, out_stride, count)};
+    pool.ParallelFor(count, mat4_chunk_size, job);
+}
+
+
+// Everything an arcball's View Projection Matrix Depends on. Projection is
+// Kept as the Matrix Values Rather Than fov, z_near, z_far so Restoring a
+// State Reproduces ViewProjMatrix() Exactly. back_vec is the Basis' Back
+// Vector, Which Translate and Zoom Leave as it was Rather Than Rebuilding
+// From camera_pos - center_pos
+struct arcball_state{
+    float camera_pos[3];
+    float center_pos[3];
+    float up_vec[3];
+    float back_vec[3];
+    float radius;
+    float aspect_ratio;
+    float pixel_to_wspace_x;
+    float pixel_to_wspace_y;
+    float m00;
+    float m11;
+    float m22;
+    float m32;
+};
+
+
+// Projection, Panning, Zooming and Rays Shared by arcball and
+// quaternion_arcball, Which Differ Only in How They Keep the Orientation.
+// Derived Supplies FormBasis(), Which Fills basis (and camera_pos When it
+// Follows From the Orientation), PlaceCamera(), Which Puts camera_pos radius
+// From center_pos Along the Back Vector, and the Names to Trace Under
+template<typename Derived>
+struct arcball_view{
+
+float rotate_sensitivity = 0.004;
+
+float zoom_sensitivity = 0.2;
+
+float zoom_translate_sensitivity = 0.1;
+
+const float *Center(){return center_pos;}
+
+float Radius() const {return radius;}
+
+// Rows are the Right, Up and Back Vectors
+const float *Basis(){
+    UpdateBasis();
+    return basis;
+}
+
+// Incremented Whenever the View Projection Matrix Changes
+unsigned Version() const {return version;}
+
+void SetRadius(const float input){
+    ThrowOnError(TrySetRadius(input));
+}
+
+// Same as SetRadius() but Returns status_negative_radius Instead of
+// Throwing, or With error_clamp Sets a Negative Radius to .001, the Same
+// Floor Zoom() Uses. Moves the Camera Along the Back Vector Like Zoom()
+template<typename Policy = error_report>
+agp_status TrySetRadius(float input) noexcept {
+    if(input < 0){
+        if(!Policy::is_clamped){return status_negative_radius;}
+        input = .001;
+    }
+    UpdateBasis();
+    radius = input;
+    static_cast<Derived*>(this)->PlaceCamera();
+    PositionChanged();
+    return status_ok;
+}
+
+void SetProjectionVars(const float fov, const float z_near, const float z_far){
+    // Change Projection Matrix Values
+    float tangent = tan(0.5*fov);
+    pixel_to_wspace_x = m00*pixel_to_wspace_x;
+    pixel_to_wspace_y = m11*pixel_to_wspace_y;
+    m00 = 1/(aspect_ratio*tangent);
+    m11 = 1/tangent;
+    pixel_to_wspace_x = aspect_ratio*tangent*pixel_to_wspace_x;
+    pixel_to_wspace_y = tangent*pixel_to_wspace_y;
+    m22 = (z_near + z_far)/(z_near - z_far);
+    m32 = 2*z_near*z_far/(z_near - z_far);
+    ProjectionChanged();
+}
+
+// Same as SetProjectionVars(), From Precomputed Values e.g. PerspectiveProjection().
+// m00 Must be for the Current Aspect Ratio
+void SetProjection(const projection_matrix &projection){
+    pixel_to_wspace_x = m00*pixel_to_wspace_x/projection.m00;
+    pixel_to_wspace_y = m11*pixel_to_wspace_y/projection.m11;
+    m00 = projection.m00;
+    m11 = projection.m11;
+    m22 = projection.m22;
+    m32 = projection.m32;
+    ProjectionChanged();
+}
+
+
+// out_vec is a 1x3 vector containing the direction vector of the ray
+void MouseRay(const float mouse_x, const float mouse_y, float *out_vec){
+    UpdateBasis();
+
+    // Find Local Direction Vector
+    float vec[3] = {-mouse_x*pixel_to_wspace_x, mouse_y*pixel_to_wspace_y, -1};
+
+    // Multiply Vector by the Basis Matrix Transposed
+    for (int i=0; i<3; i++){
+        out_vec[i] = basis[i]*vec[0] + basis[i + 3]*vec[1] + basis[i + 6]*vec[2];
+    }
+}
+
+
+// Fills Ray Directions for a width x height Tile of Pixels, the Same as
+// MouseRay(mouse_x - column, mouse_y - row) for Each Pixel. Directions go
+// to Separate x, y, z Arrays with row_stride Floats Between Rows, so a
+// Tile Can Write Straight Into a Full Frame Buffer. Rows are Split Across
+// pool, and Each Row Steps the Direction Instead of Using the Basis
+void MouseRays(const float mouse_x, const float mouse_y, const size_t width, const size_t height,
+float *dir_x, float *dir_y, float *dir_z, const size_t row_stride, thread_pool &pool = DefaultThreadPool()){
+    struct ray_job{
+        ray_steps steps;
+        size_t width;
+        float *dir_x;
+        float *dir_y;
+        float *dir_z;
+        size_t row_stride;
+        void operator()(const size_t begin, const size_t end){
+            for(size_t row=begin; row<end; row++){
+                float origin[3];
+                steps.RowOrigin(row, origin);
+                size_t offset = row*row_stride;
+                FillRayRow(origin, steps.column_step, width, dir_x + offset, dir_y + offset, dir_z + offset);
+            }
+        }
+    };
+    if(width == 0){return;}
+    ray_job job = {RaySteps(mouse_x, mouse_y), width, dir_x, dir_y, dir_z, row_stride};
+    pool.ParallelFor(height, ray_chunk_size/width + 1, job);
+}
+
+// Same Rays as MouseRays() Grouped Into Packets of packet_width Rays,
+// Each Stored as packet_width x's, Then y's, Then z's. Each Row Holds
+// ceil(width/packet_width) Packets, the Last Padded With Rays Past the
+// Tile Edge. Defaults to the Widest Register the CPU Supports
+void MouseRayPackets(const float mouse_x, const float mouse_y, const size_t width, const size_t height,
+float *packets, const size_t packet_width = SimdFloatWidth(SimdLevel()), thread_pool &pool = DefaultThreadPool()){
+    struct packet_job{
+        ray_steps steps;
+        size_t packet_count;
+        size_t packet_width;
+        float *packets;
+        void operator()(const size_t begin, const size_t end){
+            for(size_t row=begin; row<end; row++){
+                float origin[3];
+                steps.RowOrigin(row, origin);
+                for(size_t i=0; i<packet_count; i++){
+                    float *packet = packets + (row*packet_count + i)*3*packet_width;
+                    float packet_origin[3];
+                    for(int j=0; j<3; j++){
+                        packet_origin[j] = origin[j] + (float)(i*packet_width)*steps.column_step[j];
+                    }
+                    FillRayRow(packet_origin, steps.column_step, packet_width,
+                        packet, packet + packet_width, packet + 2*packet_width);
+                }
+            }
+        }
+    };
+    if(width == 0){return;}
+    size_t packet_count = (width + packet_width - 1)/packet_width;
+    packet_job job = {RaySteps(mouse_x, mouse_y), packet_count, packet_width, packets};
+    pool.ParallelFor(height, ray_chunk_size/width + 1, job);
+}
+
+// Reconstructs World Points From a width x height Image of Window Depths
+// in [0, 1], Where Pixel (column, row) Has the MouseRays() Ray and Depth
+// depth[row*row_stride + column]. Depth is Linearized With m22 and m32 and
+// Pixels at the Far Plane (Depth 1, e.g. Never Drawn) are Skipped. Calls
+// sink(x, y, z, pixels, count) With up to depth_tile_size Points as
+// Separate Arrays Plus Each Point's row*width + column. Rows are Split
+// Across pool, so sink Must be Safe to Call From Several Threads at Once.
+// Pixel Indices are 32 Bit, so Images Over 2^32 Pixels Throw
+template<typename F>
+void DepthPoints(const float mouse_x, const float mouse_y, const size_t width, const size_t height,
+const float *depth, const size_t row_stride, F &sink, thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE(Derived::depth_points_trace);
+    struct depth_job{
+        ray_steps steps;
+        float camera[3];
+        float m22;
+        float m32;
+        size_t width;
+        const float *depth;
+        size_t row_stride;
+        F &sink;
+        void operator()(const size_t begin, const size_t end){
+            float x[depth_tile_size];
+            float y[depth_tile_size];
+            float z[depth_tile_size];
+            uint32_t pixels[depth_tile_size];
+            float block[3][depth_block_size];
+            int is_drawn[depth_block_size];
+            size_t count = 0;
+
+            for(size_t row=begin; row<end; row++){
+                float origin[3];
+                steps.RowOrigin(row, origin);
+                for(size_t column=0; column<width; column+=depth_block_size){
+                    size_t size = std::min(depth_block_size, width - column);
+                    if(count + size > depth_tile_size){
+                        sink((const float*)x, (const float*)y, (const float*)z, (const uint32_t*)pixels, count);
+                        count = 0;
+                    }
+
+                    float block_origin[3];
+                    for(int i=0; i<3; i++){
+                        block_origin[i] = origin[i] + (float)column*steps.column_step[i];
+                    }
+                    FillDepthBlock(block_origin, steps.column_step, camera, m22, m32, depth + row*row_stride + column,
+                        size, block[0], block[1], block[2], is_drawn);
+
+                    // Branchless Compaction
+                    uint32_t pixel = (uint32_t)(row*width + column);
+                    for(size_t i=0; i<size; i++){
+                        x[count] = block[0][i];
+                        y[count] = block[1][i];
+                        z[count] = block[2][i];
+                        pixels[count] = pixel + i;
+                        count += is_drawn[i];
+                    }
+                }
+            }
+            if(count > 0){
+                sink((const float*)x, (const float*)y, (const float*)z, (const uint32_t*)pixels, count);
+            }
+        }
+    };
+    if(width == 0 || height == 0){return;}
+    if((uint64_t)width > ((uint64_t)1 << 32)/height){AGP_THROW("Too Many Pixels for 32 Bit Indices");}
+    depth_job job = {RaySteps(mouse_x, mouse_y), {camera_pos[0], camera_pos[1], camera_pos[2]}, m22, m32,
+        width, depth, row_stride, sink};
+    pool.ParallelFor(height, ray_chunk_size/width + 1, job);
+}
+
+
+void SetViewArea(const int window_width, const int window_height){
+    aspect_ratio = (float)window_width/(float)window_height;
+    m00 = m11*(1/aspect_ratio); // Projection Matrix Value Changes with Aspect Ratio
+    pixel_to_wspace_x = 1/(m00*0.5*window_width);
+    pixel_to_wspace_y = 1/(m11*0.5*window_height);
+    ProjectionChanged();
+}
+
+
+void Translate(const float delta_x, const float delta_y){
+    AGP_TRACE_SCOPE(Derived::translate_trace);
+
+    // Transform Screen Vector into Gobal Coordinates and Add to Camera and Center Position
+    if(delta_x == 0 && delta_y == 0){return;}
+    else{
+        UpdateBasis();
+
+        // Create Local Vector
+        float vec[2] = {-delta_x*radius*pixel_to_wspace_x, delta_y*radius*pixel_to_wspace_y};
+
+        // Multiply Vector by the Basis Matrix Transposed
+        for (int i = 0; i < 3; i++){
+            float temp = basis[i]*vec[0] + basis[i + 3]*vec[1];
+            camera_pos[i] += temp;
+            center_pos[i] += temp;
+        }
+        PositionChanged();
+    }
+}
+
+
+void Zoom(const float mouse_x, const float mouse_y, const float zoom){
+    AGP_TRACE_SCOPE(Derived::zoom_trace);
+    UpdateBasis();
+
+    // translate center and camera_pos to new mouse coordinates
+    if(zoom < 0){
+        float vec[2] = {-zoom_translate_sensitivity*mouse_x*radius*pixel_to_wspace_x, zoom_translate_sensitivity*mouse_y*radius*pixel_to_wspace_y};
+
+        // Multiply Vector by the Basis Matrix Transposed
+        for (int i = 0; i < 3; i++){
+            float temp = basis[i]*vec[0] + basis[i + 3]*vec[1];
+            camera_pos[i] += temp;
+            center_pos[i] += temp;
+        }
+    }
+
+
+    radius += zoom_sensitivity*zoom;
+
+    if(radius < 0){
+        radius = .001;
+    }
+
+    static_cast<Derived*>(this)->PlaceCamera();
+    PositionChanged();
+
+}
+
+
+// Writes the Left, Right, Bottom, Top, Near and Far Planes as 4 Floats
+// Each: a, b, c, d With Unit Normal (a, b, c) Pointing Inward, so a Point
+// is Inside When a*x + b*y + c*z + d >= 0. Built From the Basis and
+// Projection Values, Matching the Planes of ViewProjMatrix()
+void FrustumPlanes(float *planes){
+    UpdateBasis();
+
+    // Clip Space Planes w + x, w - x, ... as Multiples of the Basis
+    const float scales[6][2] = {{m00, 0}, {-m00, 0}, {m11, 0}, {-m11, 0}, {m22, m32}, {-m22, -m32}};
+    const float *rows[6] = {basis, basis, basis + 3, basis + 3, basis + 6, basis + 6};
+    for(int i=0; i<6; i++){
+        float *plane = planes + 4*i;
+        for(int j=0; j<3; j++){
+            plane[j] = scales[i][0]*rows[i][j] - basis[j + 6];
+        }
+        float inverse_length = 1/sqrt(DotVec<3>(plane, plane));
+        plane[3] = (scales[i][1] - DotVec<3>(plane, camera_pos))*inverse_length;
+        for(int j=0; j<3; j++){
+            plane[j] *= inverse_length;
+        }
+    }
+}
+
+
+// Only Recomputed When the View or Projection Changed Since the Last Call,
+// Otherwise the Cached Matrix is Copied
+void ViewProjMatrix(float *matrix){
+    AGP_TRACE_SCOPE(Derived::view_proj_trace);
+    UpdateViewProj();
+    std::copy(view_proj, view_proj + 16, matrix);
+}
+
+// Writes the View Projection Matrix in layout Straight Into matrix, e.g.
+// a Mapped Uniform Buffer, With No Temporary Copy. See StoreMat4()
+void ViewProjMatrix(float *matrix, const matrix_layout layout, const bool is_streamed = false){
+    AGP_TRACE_SCOPE(Derived::view_proj_trace);
+    UpdateViewProj();
+    StoreMat4(view_proj, matrix, layout, is_streamed);
+    if(is_streamed){StoreFence();}
+}
+
+// Exact Inverse of ViewProjMatrix(), Row Major. Maps Clip Space Back to
+// World Space, e.g. for UnprojectPoints()
+void InverseViewProjMatrix(float *matrix){
+    UpdateBasis();
+    ::InverseViewProjMatrix(basis, camera_pos, projection_matrix{m00, m11, m22, m32}, matrix);
+}
+
+
+protected:
+
+void UpdateViewProj(){
+    if(!is_matrix_current){
+        // Create Basis to Local Space from Global Space... "View Matrix"
+        UpdateBasis();
+
+        // Matrix Multiplication of View Matrix With the Sparse Projection Matrix
+        view_proj[3] = -DotVec<3>(camera_pos, basis)*m00;
+        view_proj[7] = -DotVec<3>(camera_pos, basis + 3)*m11;
+        view_proj[15] = DotVec<3>(camera_pos, basis + 6);
+        view_proj[11] = -view_proj[15]*m22 + m32;
+
+        for(int i=0; i<3; i++){
+            view_proj[i] = basis[i]*m00;
+            view_proj[i + 4] = basis[i + 3]*m11;
+            view_proj[i + 8] = basis[i + 6]*m22;
+            view_proj[i + 12] = -basis[i + 6];
+        }
+        is_matrix_current = true;
+    }
+}
+
+// The Parts of an arcball_state Kept the Same Way by Both
+void GetViewState(arcball_state &state) const {
+    std::copy(camera_pos, camera_pos + 3, state.camera_pos);
+    std::copy(center_pos, center_pos + 3, state.center_pos);
+    state.radius = radius;
+    state.aspect_ratio = aspect_ratio;
+    state.pixel_to_wspace_x = pixel_to_wspace_x;
+    state.pixel_to_wspace_y = pixel_to_wspace_y;
+    state.m00 = m00;
+    state.m11 = m11;
+    state.m22 = m22;
+    state.m32 = m32;
+}
+
+// Direction of a Tile's First Ray and How it Changes per Column and Row
+struct ray_steps{
+    float origin[3];
+    float column_step[3];
+    float row_step[3];
+
+    void RowOrigin(const size_t row, float *row_origin) const {
+        for(int i=0; i<3; i++){
+            row_origin[i] = origin[i] + (float)row*row_step[i];
+        }
+    }
+};
+
+ray_steps RaySteps(const float mouse_x, const float mouse_y){
+    ray_steps steps;
+    MouseRay(mouse_x, mouse_y, steps.origin);
+    for(int i=0; i<3; i++){
+        steps.column_step[i] = basis[i]*pixel_to_wspace_x;
+        steps.row_step[i] = -basis[i + 3]*pixel_to_wspace_y;
+    }
+    return steps;
+}
+
+// Dumb Down the Code for Auto-Vectorization
+static void FillRayRow(const float *origin, const float *step, const size_t count,
+float * __restrict__ x, float * __restrict__ y, float * __restrict__ z){
+    const float origin_x = origin[0];
+    const float origin_y = origin[1];
+    const float origin_z = origin[2];
+    const float step_x = step[0];
+    const float step_y = step[1];
+    const float step_z = step[2];
+    for(size_t i=0; i<count; i++){
+        float column = (float)i;
+        x[i] = origin_x + column*step_x;
+        y[i] = origin_y + column*step_y;
+        z[i] = origin_z + column*step_z;
+    }
+}
+
+// World Points of count Pixels Along a Row, Each at camera + distance*ray
+// Where distance = -z_view = m32/(z_ndc + m22) and z_ndc = 2*depth - 1
+static void FillDepthBlock(const float *origin, const float *step, const float *camera, const float m22,
+const float m32, const float * __restrict__ depth, const size_t count, float * __restrict__ x,
+float * __restrict__ y, float * __restrict__ z, int * __restrict__ is_drawn){
+    const float origin_x = origin[0];
+    const float origin_y = origin[1];
+    const float origin_z = origin[2];
+    const float step_x = step[0];
+    const float step_y = step[1];
+    const float step_z = step[2];
+    const float camera_x = camera[0];
+    const float camera_y = camera[1];
+    const float camera_z = camera[2];
+    for(size_t i=0; i<count; i++){
+        float column = (float)i;
+        float distance = m32/(2*depth[i] - 1 + m22);
+        x[i] = camera_x + distance*(origin_x + column*step_x);
+        y[i] = camera_y + distance*(origin_y + column*step_y);
+        z[i] = camera_z + distance*(origin_z + column*step_z);
+        is_drawn[i] = depth[i] < 1;
+    }
+}
+
+// Basis is Formed Lazily the Next Time Something Reads it
+void UpdateBasis(){
+    if(!is_basis_current){
+        static_cast<Derived*>(this)->FormBasis();
+        is_basis_current = true;
+    }
+}
+
+void ViewChanged(){
+    version++;
+    is_basis_current = false;
+    is_matrix_current = false;
+}
+
+// Translate and Zoom Move the Camera Without Turning it, so the Basis Stays
+void PositionChanged(){
+    version++;
+    is_matrix_current = false;
+}
+
+void ProjectionChanged(){
+    version++;
+    is_matrix_current = false;
+}
+
+float basis[9];
+
+float view_proj[16];
+
+bool is_basis_current = false;
+
+bool is_matrix_current = false;
+
+unsigned version = 0;
+
+float center_pos[3] = {0,0,0};
+
+float camera_pos[3] = {0,1,0};
+
+float radius = 1;
+
+float aspect_ratio = 1;
+
+// Until SetViewArea(), a Pixel is One Normalized Device Unit
+float pixel_to_wspace_x = 1/default_projection.m00;
+
+float pixel_to_wspace_y = 1/default_projection.m11;
+
+// Projection Matrix Values
+float m00 = default_projection.m00;
+
+float m11 = default_projection.m11;
+
+float m22 = default_projection.m22;
+
+float m32 = default_projection.m32;
+
+};
+
+
+//  "The engines don’t move the ship at all. The ship stays where it is 
+//  and the engines move the universe around it" -Futurama
+struct arcball : arcball_view<arcball>{
+
+void SetCamera(const float *cam_pos, const float *up){
+    AGP_TRACE_SCOPE("arcball::SetCamera");
+    ThrowOnError(TrySetCamera(cam_pos, up));
+}
+
+// Same as SetCamera() but Returns status_parallel_vectors Instead of Throwing
+agp_status TrySetCamera(const float *cam_pos, const float *up) noexcept {
+
+    // Find Cos(theta) between the two vectors
+    float cam_mag = 0;
+    float up_mag = 0;
+    for(int i=0; i<3; i++){
+        cam_mag += cam_pos[i]*cam_pos[i];
+        up_mag += up[i]*up[i];
+    }
+    float dotprod = DotVec<3>(cam_pos, up)/(sqrt(cam_mag)*sqrt(up_mag));
+    float dir_vec[3];
+
+    if( dotprod >= 0.999){
+        // Vectors are Facing the Same Direction
+        return status_parallel_vectors;
+    }
+    else if( dotprod >= 0.00001){
+        // If vectors aren't perpendicular, make them perpendicular
+        DiffVec<3>(cam_pos, center_pos, dir_vec);
+
+        float right[3];
+        CrossVec(up, dir_vec, right);
+        CrossVec(dir_vec, right, up_vec);
+    }
+    else{
+        // Vectors are Perpendicular
+        std::copy(up, up + 3, up_vec);
+        DiffVec<3>(cam_pos, center_pos, dir_vec);
+    }
+
+    std::copy(cam_pos, cam_pos + 3, camera_pos);
+    NormalizeVec<3>(up_vec);
+    ViewChanged();
+
+    radius = MagnitudeVec<3>(dir_vec);
+    return status_ok;
+}
+
+void SetCenter(const float *input){
+    std::copy(input, input+3, center_pos);
+    ViewChanged();
+    float dir_vec[3];
+    DiffVec<3>(camera_pos, center_pos, dir_vec);
+    radius = radius = MagnitudeVec<3>(dir_vec);
+}
+
+const float *Camera(){return camera_pos;}
+
+void GetState(arcball_state &state) const {
+    GetViewState(state);
+    std::copy(up_vec, up_vec + 3, state.up_vec);
+    if(is_basis_current){
+        std::copy(basis + 6, basis + 9, state.back_vec);
+    }
+    else{
+        // Same as FormBasis Would Make
+        DiffVec<3>(camera_pos, center_pos, state.back_vec);
+        NormalizeVec<3>(state.back_vec);
+    }
+}
+
+void SetState(const arcball_state &state){
+    std::copy(state.camera_pos, state.camera_pos + 3, camera_pos);
+    std::copy(state.center_pos, state.center_pos + 3, center_pos);
+    std::copy(state.up_vec, state.up_vec + 3, up_vec);
+    radius = state.radius;
+    aspect_ratio = state.aspect_ratio;
+    pixel_to_wspace_x = state.pixel_to_wspace_x;
+    pixel_to_wspace_y = state.pixel_to_wspace_y;
+    m00 = state.m00;
+    m11 = state.m11;
+    m22 = state.m22;
+    m32 = state.m32;
+    ViewChanged();
+    std::copy(state.back_vec, state.back_vec + 3, basis + 6);
+    FormRightVec();
+    is_basis_current = true;
+}
+
+
+// Math Picks the sqrt, sin and cos, e.g. Rotate<math_fast>(delta_x, delta_y)
+template<typename Math = math_precise>
+void Rotate(const float delta_x, const float delta_y){
+    AGP_TRACE_SCOPE("arcball::Rotate");
+
+    if(delta_x == 0 && delta_y == 0){return;}
+    else{
+        UpdateBasis();
+
+        // Calculate local position vector
+        float magnitude = Math::Sqrt(delta_x*delta_x + delta_y*delta_y);
+        float theta = rotate_sensitivity*magnitude;
+        float sine = Math::Sin(theta)/magnitude;
+        float cosine = Math::Cos(theta);
+        float multiplier = -delta_y*(1 - cosine)/(magnitude*magnitude);
+
+        float vec[3] = { -delta_x*radius*sine, delta_y*radius*sine, radius*cosine - radius};
+
+        float vec2[3] = {delta_x*multiplier, delta_y*multiplier, - delta_y*sine};
+
+        // Multiply Transposed Basis Matrix by the Unit Vector and Add
+        for(int i=0; i<3; i++){
+            // Dumb Down the Code for Auto-Vectorization
+            for (int j=0; j<3; j++){
+                camera_pos[i] += basis[i + j*3]*vec[j];
+                up_vec[i] += basis[i + j*3]*vec2[j];
+            }
+        }
+        ViewChanged();
+    }
+}
+
+
+// Rotates the Camera About the Center by a 3x3 Row Major Rotation Matrix
+// in Local Coordinates (x Right, y Up, z Back). Moves the Camera and Up
+// Vector the Same Way Rotate() Does, so a Rotate() is One Local Rotation
+void RotateLocal(const float *rotation){
+    UpdateBasis();
+
+    // Local Displacements of the Camera (radius*z) and Up Vector (y)
+    float vec[3] = {radius*rotation[2], radius*rotation[5], radius*rotation[8] - radius};
+
+    float vec2[3] = {rotation[1], rotation[4] - 1, rotation[7]};
+
+    // Multiply Transposed Basis Matrix by the Displacements and Add
+    for(int i=0; i<3; i++){
+        for (int j=0; j<3; j++){
+            camera_pos[i] += basis[i + j*3]*vec[j];
+            up_vec[i] += basis[i + j*3]*vec2[j];
+        }
+    }
+    ViewChanged();
+}
+
+
+private:
+
+friend struct arcball_view<arcball>;
+
+friend struct arcball_batch;
+
+static constexpr const char *translate_trace = "arcball::Translate";
+
+static constexpr const char *zoom_trace = "arcball::Zoom";
+
+static constexpr const char *view_proj_trace = "arcball::ViewProjMatrix";
+
+static constexpr const char *depth_points_trace = "arcball::DepthPoints";
+
+void FormBasis(){
+    for (int i=0; i<3; i++){
+        basis[i + 6] = camera_pos[i] - center_pos[i];
+    }
+    NormalizeVec<3>(basis + 6);
+    FormRightVec();
+}
+
+// Up and Right Rows From up_vec and the Back Row
+void FormRightVec(){
+    std::copy(up_vec, up_vec + 3, basis + 3);
+    CrossVec(basis + 3, basis + 6, basis);
+    NormalizeVec<3>(basis);
+}
+
+// Keeps the Direction From the Center and Sets the Distance to radius
+void PlaceCamera(){
+    float dir_vec[3];
+    DiffVec<3>(camera_pos, center_pos, dir_vec);
+    NormalizeVec<3>(dir_vec);
+    for (int i=0; i<3; i++){
+        camera_pos[i] = dir_vec[i]*radius + center_pos[i];
+    }
+}
+
+float up_vec[3] = {0,0,1};
+
+};
+
+
+
+// Structure of Arrays Container for Driving Many Arcballs at Once.
+// Rotate, Translate and Zoom Deltas are Queued per Camera and Applied to
+// Every Camera in One Pass, Equivalent to Calling Rotate, Translate, Zoom
+// and ViewProjMatrix on Each arcball Individually, in That Order. Several
+// Queued Rotations Compose Into One Like arcball_event_queue's, so They
+// Match Sequential Rotates Up to the Same Small Up Vector Drift
+struct arcball_batch{
+
+// Adds a Copy of arc to the Batch and Returns its Index
+size_t Add(const arcball &arc){
+    size_t index = Size();
+    Resize(index + 1);
+    Set(index, arc);
+    return index;
+}
+
+// Overwrites the Camera at index with a Copy of arc
+void Set(const size_t index, const arcball &arc){
+    for(int i=0; i<3; i++){
+        camera_pos[i][index] = arc.camera_pos[i];
+        center_pos[i][index] = arc.center_pos[i];
+        up_vec[i][index] = arc.up_vec[i];
+    }
+    radius[index] = arc.radius;
+    aspect_ratio[index] = arc.aspect_ratio;
+    pixel_to_wspace_x[index] = arc.pixel_to_wspace_x;
+    pixel_to_wspace_y[index] = arc.pixel_to_wspace_y;
+    m00[index] = arc.m00;
+    m11[index] = arc.m11;
+    m22[index] = arc.m22;
+    m32[index] = arc.m32;
+    rotate_sensitivity[index] = arc.rotate_sensitivity;
+    zoom_sensitivity[index] = arc.zoom_sensitivity;
+    zoom_translate_sensitivity[index] = arc.zoom_translate_sensitivity;
+    for(int i=0; i<3; i++){
+        rotate_camera[i][index] = i == 2;
+        rotate_up[i][index] = 0;
+    }
+    rotate_sine[index] = 0;
+    for(int i=0; i<2; i++){
+        translate_delta[i][index] = 0;
+        zoom_mouse[i][index] = 0;
+    }
+    rotate_count[index] = 0;
+    zoom_count[index] = 0;
+    FormBasis<1>(index);
+}
+
+// Copies the Camera at index Back Into arc
+void Get(const size_t index, arcball &arc){
+    for(int i=0; i<3; i++){
+        arc.camera_pos[i] = camera_pos[i][index];
+        arc.center_pos[i] = center_pos[i][index];
+        arc.up_vec[i] = up_vec[i][index];
+    }
+    arc.ViewChanged();
+    for(int i=0; i<9; i++){
+        arc.basis[i] = basis[i][index];
+    }
+    arc.is_basis_current = true;
+    arc.radius = radius[index];
+    arc.aspect_ratio = aspect_ratio[index];
+    arc.pixel_to_wspace_x = pixel_to_wspace_x[index];
+    arc.pixel_to_wspace_y = pixel_to_wspace_y[index];
+    arc.m00 = m00[index];
+    arc.m11 = m11[index];
+    arc.m22 = m22[index];
+    arc.m32 = m32[index];
+    arc.rotate_sensitivity = rotate_sensitivity[index];
+    arc.zoom_sensitivity = zoom_sensitivity[index];
+    arc.zoom_translate_sensitivity = zoom_translate_sensitivity[index];
+}
+
+size_t Size() const {return camera_count;}
+
+// Each Rotate is a Rotation by rotate_sensitivity*|delta| About the Local
+// Axis (-delta_y, -delta_x, 0)/|delta|, so Queued Rotations Compose Into
+// One Quaternion per Camera. sin and cos Run Here, Once per Delta, and
+// Update() Applies the Result Like arcball::RotateLocal(). A Single
+// Rotation Keeps arcball::Rotate's Own Terms
+void QueueRotate(const size_t index, const float delta_x, const float delta_y){
+    if(delta_x == 0 && delta_y == 0){return;}
+
+    float magnitude = sqrt(delta_x*delta_x + delta_y*delta_y);
+    float theta = rotate_sensitivity[index]*magnitude;
+    float half_sine = sin(0.5f*theta)/magnitude;
+    float step[3] = {(float)cos(0.5f*theta), -delta_y*half_sine, -delta_x*half_sine};
+
+    // total * step, Where step Has No z
+    float q[4] = {1, 0, 0, 0};
+    if(rotate_count[index] != 0){
+        for(int i=0; i<4; i++){q[i] = rotate_quat[i][index];}
+    }
+    float total[4] = {q[0]*step[0] - q[1]*step[1] - q[2]*step[2], q[0]*step[1] + q[1]*step[0] - q[3]*step[2],
+        q[0]*step[2] + q[2]*step[0] + q[3]*step[1], q[1]*step[2] - q[2]*step[1] + q[3]*step[0]};
+    NormalizeVec<4>(total);
+    for(int i=0; i<4; i++){rotate_quat[i][index] = total[i];}
+
+    if(rotate_count[index] == 0){
         float sine = sin(theta)/magnitude;
         float cosine = cos(theta);
         float multiplier = -delta_y*(1 - cosine)/(magnitude*magnitude);
+        rotate_camera[0][index] = -delta_x;
+        rotate_camera[1][index] = delta_y;
+        rotate_camera[2][index] = cosine;
+        rotate_sine[index] = sine;
+        rotate_up[0][index] = delta_x*multiplier;
+        rotate_up[1][index] = delta_y*multiplier;
+        rotate_up[2][index] = -delta_y*sine;
+    }
+    else{
+        // z Column of quaternion::RotationMatrix3() and its y Column Minus y
+        rotate_camera[0][index] = 2*(total[1]*total[3] + total[0]*total[2]);
+        rotate_camera[1][index] = 2*(total[2]*total[3] - total[0]*total[1]);
+        rotate_camera[2][index] = 2*(total[0]*total[0] + total[3]*total[3]) - 1;
+        rotate_sine[index] = 1;
+        rotate_up[0][index] = 2*(total[1]*total[2] - total[0]*total[3]);
+        rotate_up[1][index] = 2*(total[0]*total[0] + total[2]*total[2]) - 1 - 1;
+        rotate_up[2][index] = 2*(total[2]*total[3] + total[0]*total[1]);
+    }
+    rotate_count[index] += 1;
+}
+
+// Queued Translations are Summed Until the Next Update
+void QueueTranslate(const size_t index, const float delta_x, const float delta_y){
+    translate_delta[0][index] += delta_x;
+    translate_delta[1][index] += delta_y;
+}
+
+// Replays the Radius Sequence of the Queued Zooms Like arcball_event_queue.
+// Each Negative Zoom Translates Toward its Mouse Position in Proportion to
+// the Radius at That Step, so They Sum Into One Translate Before One
+// Radius Change
+void QueueZoom(const size_t index, const float mouse_x, const float mouse_y, const float zoom){
+    if(zoom_count[index] == 0){zoom_radius[index] = radius[index];}
+    if(zoom < 0){
+        zoom_mouse[0][index] += mouse_x*zoom_radius[index];
+        zoom_mouse[1][index] += mouse_y*zoom_radius[index];
+    }
+    zoom_radius[index] += zoom_sensitivity[index]*zoom;
+    if(zoom_radius[index] < 0){zoom_radius[index] = .001;}
+    zoom_count[index] += 1;
+}
+
+// Applies All Queued Deltas
+void Update(){
+    for(size_t begin=0; begin<Size(); begin+=block_size){
+        UpdateBlock(begin);
+    }
+}
+
+// Applies All Queued Deltas and Writes Size() Row Major View Projection
+// Matrices Contiguously to matrices (16 floats per camera)
+void Update(float *matrices){
+    for(size_t begin=0; begin<Size(); begin+=block_size){
+        size_t end = std::min(begin + block_size, Size());
+        UpdateBlock(begin);
+        ViewProjMatrices(begin, end, matrices + 16*begin);
+    }
+}
+
+// Same as Update(matrices) Writing Matrix i in layout to matrices + i*stride,
+// e.g. Straight Into a Mapped Instance Buffer. See StoreMat4()
+void Update(float *matrices, const size_t stride, const matrix_layout layout, const bool is_streamed = false){
+    float block[16*block_size];
+    for(size_t begin=0; begin<Size(); begin+=block_size){
+        size_t end = std::min(begin + block_size, Size());
+        UpdateBlock(begin);
+        ViewProjMatrices(begin, end, block);
+        StoreMatrices(block, begin, end, matrices, stride, layout, is_streamed);
+    }
+    if(is_streamed){StoreFence();}
+}
+
+// Writes Size() Row Major View Projection Matrices Contiguously to matrices
+void ViewProjMatrices(float *matrices){
+    ViewProjMatrices(0, Size(), matrices);
+}
+
+// Writes Matrix i in layout to matrices + i*stride. See StoreMat4()
+void ViewProjMatrices(float *matrices, const size_t stride, const matrix_layout layout, const bool is_streamed = false){
+    float block[16*block_size];
+    for(size_t begin=0; begin<Size(); begin+=block_size){
+        size_t end = std::min(begin + block_size, Size());
+        ViewProjMatrices(begin, end, block);
+        StoreMatrices(block, begin, end, matrices, stride, layout, is_streamed);
+    }
+    if(is_streamed){StoreFence();}
+}
+
+
+private:
+
+friend struct arcball_inertia_batch;
+
+// Cameras Processed per Stage so the Working Set Stays in L1. Storage is
+// Padded to Whole Blocks so Every Stage Loops a Constant block_size Times,
+// Which the Vectorizer Needs at -O2
+static const size_t block_size = 256;
+
+void Resize(const size_t size){
+    size_t padded = (size + block_size - 1)/block_size*block_size;
+    for(int i=0; i<3; i++){
+        camera_pos[i].resize(padded);
+        center_pos[i].resize(padded);
+        up_vec[i].resize(padded);
+    }
+    for(int i=0; i<9; i++){
+        basis[i].resize(padded);
+    }
+    for(int i=0; i<4; i++){
+        rotate_quat[i].resize(padded);
+    }
+    for(int i=0; i<3; i++){
+        rotate_camera[i].resize(padded, i == 2);
+        rotate_up[i].resize(padded);
+    }
+    rotate_sine.resize(padded);
+    for(int i=0; i<2; i++){
+        translate_delta[i].resize(padded);
+        zoom_mouse[i].resize(padded);
+    }
+    radius.resize(padded);
+    aspect_ratio.resize(padded);
+    pixel_to_wspace_x.resize(padded);
+    pixel_to_wspace_y.resize(padded);
+    m00.resize(padded);
+    m11.resize(padded);
+    m22.resize(padded);
+    m32.resize(padded);
+    rotate_sensitivity.resize(padded);
+    zoom_sensitivity.resize(padded);
+    zoom_translate_sensitivity.resize(padded);
+    rotate_count.resize(padded);
+    zoom_radius.resize(padded);
+    zoom_count.resize(padded);
+    camera_count = size;
+
+    // Padding Holds the Default arcball View so its Math Stays Finite
+    for(size_t i=size; i<padded; i++){
+        camera_pos[1][i] = 1;
+        up_vec[2][i] = 1;
+        basis[0][i] = -1;
+        basis[5][i] = 1;
+        basis[7][i] = 1;
+        radius[i] = 1;
+    }
+}
+
+// Stages Holding Nothing Queued for the Block are Skipped. Each Stage
+// Gathers its Arrays and Hands Them to a Static Kernel, so __restrict__
+// Holds and the Loops Vectorize
+void UpdateBlock(const size_t begin){
+    if(IsAnyNonZero(rotate_count.data() + begin)){
+        Rotate(begin);
+        FormBasis<block_size>(begin);
+    }
+    if(IsAnyNonZero(translate_delta[0].data() + begin) || IsAnyNonZero(translate_delta[1].data() + begin)){
+        Translate(begin);
+    }
+    if(IsAnyNonZero(zoom_count.data() + begin)){
+        Zoom(begin);
+    }
+}
+
+// Same Operations in the Same Order as arcball::FormBasis, for Cameras
+// begin to begin + count
+template<size_t count>
+void FormBasis(const size_t begin){
+    float back_scale[count];
+    float right_scale[count];
+    BackKernel<count>(camera_pos[0].data() + begin, camera_pos[1].data() + begin, camera_pos[2].data() + begin,
+        center_pos[0].data() + begin, center_pos[1].data() + begin, center_pos[2].data() + begin,
+        basis[6].data() + begin, basis[7].data() + begin, basis[8].data() + begin, back_scale);
+    InverseSqrts<count>(back_scale);
+    RightKernel<count>(up_vec[0].data() + begin, up_vec[1].data() + begin, up_vec[2].data() + begin, back_scale,
+        basis[6].data() + begin, basis[7].data() + begin, basis[8].data() + begin,
+        basis[0].data() + begin, basis[1].data() + begin, basis[2].data() + begin, right_scale);
+    InverseSqrts<count>(right_scale);
+    UpKernel<count>(up_vec[0].data() + begin, up_vec[1].data() + begin, up_vec[2].data() + begin, right_scale,
+        basis[0].data() + begin, basis[1].data() + begin, basis[2].data() + begin,
+        basis[3].data() + begin, basis[4].data() + begin, basis[5].data() + begin);
+}
+
+// Moves Each Camera by its Queued Rotation
+void Rotate(const size_t begin){
+    RotateKernel(radius.data() + begin, rotate_count.data() + begin, rotate_sine.data() + begin,
+        rotate_camera[0].data() + begin, rotate_camera[1].data() + begin, rotate_camera[2].data() + begin,
+        rotate_up[0].data() + begin, rotate_up[1].data() + begin, rotate_up[2].data() + begin,
+        basis[0].data() + begin, basis[1].data() + begin, basis[2].data() + begin,
+        basis[3].data() + begin, basis[4].data() + begin, basis[5].data() + begin,
+        basis[6].data() + begin, basis[7].data() + begin, basis[8].data() + begin,
+        camera_pos[0].data() + begin, camera_pos[1].data() + begin, camera_pos[2].data() + begin,
+        up_vec[0].data() + begin, up_vec[1].data() + begin, up_vec[2].data() + begin);
+}
+
+// Same Operations as arcball::Translate
+void Translate(const size_t begin){
+    TranslateKernel(radius.data() + begin, pixel_to_wspace_x.data() + begin, pixel_to_wspace_y.data() + begin,
+        translate_delta[0].data() + begin, translate_delta[1].data() + begin,
+        basis[0].data() + begin, basis[1].data() + begin, basis[2].data() + begin,
+        basis[3].data() + begin, basis[4].data() + begin, basis[5].data() + begin,
+        camera_pos[0].data() + begin, camera_pos[1].data() + begin, camera_pos[2].data() + begin,
+        center_pos[0].data() + begin, center_pos[1].data() + begin, center_pos[2].data() + begin);
+}
+
+// Same Operations as arcball::Zoom on the Summed Translate and Final
+// Radius of Each Camera's Queued Zooms. Cameras With no Queued Zoom are Unchanged
+void Zoom(const size_t begin){
+    float scales[block_size];
+    ZoomTranslateKernel(pixel_to_wspace_x.data() + begin, pixel_to_wspace_y.data() + begin,
+        zoom_translate_sensitivity.data() + begin, zoom_mouse[0].data() + begin, zoom_mouse[1].data() + begin,
+        basis[0].data() + begin, basis[1].data() + begin, basis[2].data() + begin,
+        basis[3].data() + begin, basis[4].data() + begin, basis[5].data() + begin,
+        camera_pos[0].data() + begin, camera_pos[1].data() + begin, camera_pos[2].data() + begin,
+        center_pos[0].data() + begin, center_pos[1].data() + begin, center_pos[2].data() + begin, scales);
+    InverseSqrts<block_size>(scales);
+    ZoomRadiusKernel(scales, zoom_radius.data() + begin, center_pos[0].data() + begin,
+        center_pos[1].data() + begin, center_pos[2].data() + begin, zoom_count.data() + begin,
+        radius.data() + begin, camera_pos[0].data() + begin, camera_pos[1].data() + begin,
+        camera_pos[2].data() + begin);
+}
+
+static bool IsAnyNonZero(const float * __restrict__ values){
+    int is_non_zero = 0;
+    for(size_t i=0; i<block_size; i++){
+        is_non_zero |= values[i] != 0;
+    }
+    return is_non_zero != 0;
+}
+
+// Separate so the Loops Around it Vectorize Even Though sqrt Sets errno.
+// With -fno-math-errno This One Vectorizes Too
+template<size_t count>
+static void InverseSqrts(float * __restrict__ values){
+    for(size_t i=0; i<count; i++){
+        values[i] = 1/sqrt(values[i]);
+    }
+}
+
+// Lengths are Summed in NormalizeVec's Order so Contracted Multiply-Adds
+// Round the Same as arcball's
+
+// z = camera - center, Squared Length to length
+template<size_t count>
+static void BackKernel(const float * __restrict__ cx, const float * __restrict__ cy, const float * __restrict__ cz,
+const float * __restrict__ ox, const float * __restrict__ oy, const float * __restrict__ oz,
+float * __restrict__ z0, float * __restrict__ z1, float * __restrict__ z2, float * __restrict__ length){
+    for(size_t i=0; i<count; i++){
+        z0[i] = cx[i] - ox[i];
+        z1[i] = cy[i] - oy[i];
+        z2[i] = cz[i] - oz[i];
+        float sum = 0;
+        sum += z0[i]*z0[i];
+        sum += z1[i]*z1[i];
+        sum += z2[i]*z2[i];
+        length[i] = sum;
+    }
+}
+
+// Normalizes z by z_scale, x = up x z, Squared Length to length
+template<size_t count>
+static void RightKernel(const float * __restrict__ ux, const float * __restrict__ uy, const float * __restrict__ uz,
+const float * __restrict__ z_scale, float * __restrict__ z0, float * __restrict__ z1, float * __restrict__ z2,
+float * __restrict__ x0, float * __restrict__ x1, float * __restrict__ x2, float * __restrict__ length){
+    for(size_t i=0; i<count; i++){
+        float back[3] = {z0[i]*z_scale[i], z1[i]*z_scale[i], z2[i]*z_scale[i]};
+        z0[i] = back[0];
+        z1[i] = back[1];
+        z2[i] = back[2];
+        x0[i] = uy[i]*back[2] - uz[i]*back[1];
+        x1[i] = uz[i]*back[0] - ux[i]*back[2];
+        x2[i] = ux[i]*back[1] - uy[i]*back[0];
+        float sum = 0;
+        sum += x0[i]*x0[i];
+        sum += x1[i]*x1[i];
+        sum += x2[i]*x2[i];
+        length[i] = sum;
+    }
+}
+
+// Normalizes x by x_scale and Copies the Up Vector Into the Basis
+template<size_t count>
+static void UpKernel(const float * __restrict__ ux, const float * __restrict__ uy, const float * __restrict__ uz,
+const float * __restrict__ x_scale, float * __restrict__ x0, float * __restrict__ x1, float * __restrict__ x2,
+float * __restrict__ y0, float * __restrict__ y1, float * __restrict__ y2){
+    for(size_t i=0; i<count; i++){
+        x0[i] = x0[i]*x_scale[i];
+        x1[i] = x1[i]*x_scale[i];
+        x2[i] = x2[i]*x_scale[i];
+        y0[i] = ux[i];
+        y1[i] = uy[i];
+        y2[i] = uz[i];
+    }
+}
+
+// Adds the Local Displacements of the Camera and Up Vector Through the
+// Basis as arcball::RotateLocal() Does, Then Clears the Queue. Unrotated
+// Cameras Add Zero
+static void RotateKernel(const float * __restrict__ r, float * __restrict__ count, float * __restrict__ sine,
+float * __restrict__ v0, float * __restrict__ v1, float * __restrict__ v2,
+float * __restrict__ w0, float * __restrict__ w1, float * __restrict__ w2,
+const float * __restrict__ b0, const float * __restrict__ b1, const float * __restrict__ b2,
+const float * __restrict__ b3, const float * __restrict__ b4, const float * __restrict__ b5,
+const float * __restrict__ b6, const float * __restrict__ b7, const float * __restrict__ b8,
+float * __restrict__ cx, float * __restrict__ cy, float * __restrict__ cz,
+float * __restrict__ ux, float * __restrict__ uy, float * __restrict__ uz){
+    for(size_t i=0; i<block_size; i++){
+        float vec[3] = {v0[i]*r[i]*sine[i], v1[i]*r[i]*sine[i], r[i]*v2[i] - r[i]};
+        float vec2[3] = {w0[i], w1[i], w2[i]};
+
+        // Written Out in arcball::Rotate's Order, Nested Loops Block Vectorization at -O2
+        cx[i] = cx[i] + b0[i]*vec[0];
+        cx[i] = cx[i] + b3[i]*vec[1];
+        cx[i] = cx[i] + b6[i]*vec[2];
+        cy[i] = cy[i] + b1[i]*vec[0];
+        cy[i] = cy[i] + b4[i]*vec[1];
+        cy[i] = cy[i] + b7[i]*vec[2];
+        cz[i] = cz[i] + b2[i]*vec[0];
+        cz[i] = cz[i] + b5[i]*vec[1];
+        cz[i] = cz[i] + b8[i]*vec[2];
+        ux[i] = ux[i] + b0[i]*vec2[0];
+        ux[i] = ux[i] + b3[i]*vec2[1];
+        ux[i] = ux[i] + b6[i]*vec2[2];
+        uy[i] = uy[i] + b1[i]*vec2[0];
+        uy[i] = uy[i] + b4[i]*vec2[1];
+        uy[i] = uy[i] + b7[i]*vec2[2];
+        uz[i] = uz[i] + b2[i]*vec2[0];
+        uz[i] = uz[i] + b5[i]*vec2[1];
+        uz[i] = uz[i] + b8[i]*vec2[2];
+        v0[i] = 0;
+        v1[i] = 0;
+        v2[i] = 1;
+        sine[i] = 0;
+        w0[i] = 0;
+        w1[i] = 0;
+        w2[i] = 0;
+        count[i] = 0;
+    }
+}
+
+static void TranslateKernel(const float * __restrict__ r, const float * __restrict__ px,
+const float * __restrict__ py, float * __restrict__ dx, float * __restrict__ dy,
+const float * __restrict__ b0, const float * __restrict__ b1, const float * __restrict__ b2,
+const float * __restrict__ b3, const float * __restrict__ b4, const float * __restrict__ b5,
+float * __restrict__ cx, float * __restrict__ cy, float * __restrict__ cz,
+float * __restrict__ ox, float * __restrict__ oy, float * __restrict__ oz){
+    for(size_t i=0; i<block_size; i++){
+        float vec[2] = {-dx[i]*r[i]*px[i], dy[i]*r[i]*py[i]};
+        float t0 = b0[i]*vec[0] + b3[i]*vec[1];
+        float t1 = b1[i]*vec[0] + b4[i]*vec[1];
+        float t2 = b2[i]*vec[0] + b5[i]*vec[1];
+        cx[i] += t0;
+        cy[i] += t1;
+        cz[i] += t2;
+        ox[i] += t0;
+        oy[i] += t1;
+        oz[i] += t2;
+        dx[i] = 0;
+        dy[i] = 0;
+    }
+}
+
+// Moves Cameras by Their Summed Zoom Translate, Squared Distance to the Center to length
+static void ZoomTranslateKernel(const float * __restrict__ px, const float * __restrict__ py,
+const float * __restrict__ translate_sensitivity, float * __restrict__ mx, float * __restrict__ my,
+const float * __restrict__ b0, const float * __restrict__ b1, const float * __restrict__ b2,
+const float * __restrict__ b3, const float * __restrict__ b4, const float * __restrict__ b5,
+float * __restrict__ cx, float * __restrict__ cy, float * __restrict__ cz,
+float * __restrict__ ox, float * __restrict__ oy, float * __restrict__ oz, float * __restrict__ length){
+    for(size_t i=0; i<block_size; i++){
+        float vec[2] = {-translate_sensitivity[i]*mx[i]*px[i], translate_sensitivity[i]*my[i]*py[i]};
+        float t0 = b0[i]*vec[0] + b3[i]*vec[1];
+        float t1 = b1[i]*vec[0] + b4[i]*vec[1];
+        float t2 = b2[i]*vec[0] + b5[i]*vec[1];
+        cx[i] += t0;
+        cy[i] += t1;
+        cz[i] += t2;
+        ox[i] += t0;
+        oy[i] += t1;
+        oz[i] += t2;
+        mx[i] = 0;
+        my[i] = 0;
+        float d[3] = {cx[i] - ox[i], cy[i] - oy[i], cz[i] - oz[i]};
+        float sum = 0;
+        sum += d[0]*d[0];
+        sum += d[1]*d[1];
+        sum += d[2]*d[2];
+        length[i] = sum;
+    }
+}
+
+// Places Zoomed Cameras at the New Radius Along Their Normalized Direction
+static void ZoomRadiusKernel(const float * __restrict__ scale, const float * __restrict__ zoom_radius,
+const float * __restrict__ ox, const float * __restrict__ oy, const float * __restrict__ oz,
+float * __restrict__ count, float * __restrict__ r,
+float * __restrict__ cx, float * __restrict__ cy, float * __restrict__ cz){
+    // Both Choices Go Through Local Arrays so the Select Below Can't Trap or
+    // Become a Conditional Store, Either of Which Turns it Into a Branch
+    float zoomed[3][block_size];
+    float kept[3][block_size];
+    float new_radius[block_size];
+    for(size_t i=0; i<block_size; i++){
+        // Loaded Outside the Select, a Conditional Load Blocks Vectorization
+        float queued_radius = zoom_radius[i];
+        new_radius[i] = count[i] != 0 ? queued_radius : r[i];
+        kept[0][i] = cx[i];
+        kept[1][i] = cy[i];
+        kept[2][i] = cz[i];
+        zoomed[0][i] = (cx[i] - ox[i])*scale[i]*new_radius[i] + ox[i];
+        zoomed[1][i] = (cy[i] - oy[i])*scale[i]*new_radius[i] + oy[i];
+        zoomed[2][i] = (cz[i] - oz[i])*scale[i]*new_radius[i] + oz[i];
+    }
+    for(size_t i=0; i<block_size; i++){
+        bool is_zoomed = count[i] != 0;
+        cx[i] = is_zoomed ? zoomed[0][i] : kept[0][i];
+        cy[i] = is_zoomed ? zoomed[1][i] : kept[1][i];
+        cz[i] = is_zoomed ? zoomed[2][i] : kept[2][i];
+        r[i] = new_radius[i];
+        count[i] = 0;
+    }
+}
+
+// Same Operations as arcball::ViewProjMatrix With the Basis Already Formed
+// Writes the Matrices of Cameras begin to end Contiguously From matrices
+void ViewProjMatrices(const size_t begin, const size_t end, float * __restrict__ matrices){
+    const float * __restrict__ cx = camera_pos[0].data();
+    const float * __restrict__ cy = camera_pos[1].data();
+    const float * __restrict__ cz = camera_pos[2].data();
+    const float * __restrict__ b0 = basis[0].data();
+    const float * __restrict__ b1 = basis[1].data();
+    const float * __restrict__ b2 = basis[2].data();
+    const float * __restrict__ b3 = basis[3].data();
+    const float * __restrict__ b4 = basis[4].data();
+    const float * __restrict__ b5 = basis[5].data();
+    const float * __restrict__ b6 = basis[6].data();
+    const float * __restrict__ b7 = basis[7].data();
+    const float * __restrict__ b8 = basis[8].data();
+    const float * __restrict__ p00 = m00.data();
+    const float * __restrict__ p11 = m11.data();
+    const float * __restrict__ p22 = m22.data();
+    const float * __restrict__ p32 = m32.data();
+
+    for(size_t i=begin; i<end; i++){
+        float *matrix = matrices + 16*(i - begin);
+        float bx[3] = {b0[i], b1[i], b2[i]};
+        float by[3] = {b3[i], b4[i], b5[i]};
+        float bz[3] = {b6[i], b7[i], b8[i]};
+        float cam[3] = {cx[i], cy[i], cz[i]};
+
+        matrix[3] = -DotVec<3>(cam, bx)*p00[i];
+        matrix[7] = -DotVec<3>(cam, by)*p11[i];
+        matrix[15] = DotVec<3>(cam, bz);
+        matrix[11] = -matrix[15]*p22[i] + p32[i];
+
+        for(int k=0; k<3; k++){
+            matrix[k] = bx[k]*p00[i];
+            matrix[k + 4] = by[k]*p11[i];
+            matrix[k + 8] = bz[k]*p22[i];
+            matrix[k + 12] = -bz[k];
+        }
+    }
+}
+
+void StoreMatrices(const float *block, const size_t begin, const size_t end, float *matrices,
+const size_t stride, const matrix_layout layout, const bool is_streamed){
+    for(size_t i=begin; i<end; i++){
+        StoreMat4(block + 16*(i - begin), matrices + i*stride, layout, is_streamed);
+    }
+}
+
+std::vector<float> camera_pos[3];
+
+std::vector<float> center_pos[3];
+
+std::vector<float> up_vec[3];
+
+std::vector<float> basis[9];
+
+std::vector<float> radius;
+
+std::vector<float> aspect_ratio;
+
+std::vector<float> pixel_to_wspace_x;
+
+std::vector<float> pixel_to_wspace_y;
+
+// Projection Matrix Values
+std::vector<float> m00;
+
+std::vector<float> m11;
+
+std::vector<float> m22;
+
+std::vector<float> m32;
+
+std::vector<float> rotate_sensitivity;
+
+std::vector<float> zoom_sensitivity;
+
+std::vector<float> zoom_translate_sensitivity;
+
+// Queued Rotation as a Quaternion (w, x, y, z) and the Local Displacements
+// it Gives the Camera and Up Vector. The Camera Moves by radius Times
+// (x*sine, y*sine, z - 1) of rotate_camera, Kept in arcball::Rotate's Terms
+// for a Single Rotation and With a sine of 1 for Several
+std::vector<float> rotate_quat[4];
+
+std::vector<float> rotate_camera[3];
+
+std::vector<float> rotate_sine;
+
+std::vector<float> rotate_up[3];
+
+std::vector<float> translate_delta[2];
+
+// Mouse Positions of the Queued Negative Zooms, Each Times the Radius Then,
+// Summed, and the Radius After All Queued Zooms
+std::vector<float> zoom_mouse[2];
+
+std::vector<float> zoom_radius;
+
+// Counts of Queued Rotations and Zooms, Floats so IsAnyNonZero Scans Them
+std::vector<float> rotate_count;
+
+std::vector<float> zoom_count;
+
+size_t camera_count = 0;
+
+};
+
+
+
+// Advances accumulator by elapsed Seconds and Takes Out Whole Steps of
+// time_step. Returns false if No Step Completed, Otherwise Sets steps, gain,
+// the Seconds of Starting Velocity Those Steps Add Up to as the Velocity
+// Decays by damping per Second, decay, What the Velocity is Multiplied by
+// After Them, and lag, the Seconds of Starting Velocity Already Applied
+// Before Each Step Summed Over the Steps. All are Summed in Closed Form
+bool InertiaSteps(const float time_step, const float damping, const float elapsed, float &accumulator,
+float &steps, float &gain, float &decay, float &lag){
+    if(time_step <= 0){AGP_THROW("Time Step Not Positive");}
+    accumulator += elapsed;
+    steps = floor(accumulator/time_step);
+    if(steps < 1){return false;}
+    accumulator -= steps*time_step;
+
+    float retention = exp(-damping*time_step);
+    decay = exp(-damping*time_step*steps);
+    gain = retention < 1 ? time_step*(1 - decay)/(1 - retention) : time_step*steps;
+    lag = retention < 1 ? (time_step*steps - gain)/(1 - retention) : time_step*steps*(steps - 1)/2;
+    return true;
+}
+
+// Zoom to Cursor Moves the Center in Proportion to the Radius at Each
+// Step, Which Changes as it Zooms. Multiplying the Mouse Position by the
+// Radius Summed Over the Steps Over the Starting radius Makes One Zoom()
+// Move as Far as the Steps Would, Until the Radius Clamps
+float InertiaZoomMouseScale(const float steps, const float lag, const float radius_velocity, const float radius){
+    return steps + radius_velocity*lag/radius;
+}
+
+
+// Momentum for an arcball or quaternion_arcball After a Flick. Add*() Sets
+// Velocities in Deltas per Second, the Units Rotate(), Translate() and
+// Zoom() Take, Which Decay by damping per Second. Update() Runs Whole Fixed
+// Steps of time_step but Sums Their Deltas in Closed Form, so a Frame
+// Costs One Rotate(), Translate() and Zoom() However Many Steps Passed.
+// Each on its Own Matches Stepping One at a Time, Including Zoom to Cursor
+// Until the Radius Clamps, Except Diagonal Rotation of an arcball, Whose
+// Rotate() Doesn't Keep the Basis Rigid so Splitting a Delta Changes the
+// Result Slightly. quaternion_arcball Matches Exactly
+struct arcball_inertia{
+
+// Member Functions
+
+void AddRotate(const float velocity_x, const float velocity_y){
+    rotate_velocity[0] += velocity_x;
+    rotate_velocity[1] += velocity_y;
+}
+
+void AddTranslate(const float velocity_x, const float velocity_y){
+    translate_velocity[0] += velocity_x;
+    translate_velocity[1] += velocity_y;
+}
+
+// Zooms Toward the Last mouse_x, mouse_y Given
+void AddZoom(const float mouse_x, const float mouse_y, const float velocity){
+    zoom_mouse[0] = mouse_x;
+    zoom_mouse[1] = mouse_y;
+    zoom_velocity += velocity;
+}
+
+// Drops All Velocity, e.g. When the User Grabs the Camera Again
+void Stop(){
+    rotate_velocity[0] = rotate_velocity[1] = 0;
+    translate_velocity[0] = translate_velocity[1] = 0;
+    zoom_velocity = 0;
+    accumulator = 0;
+}
+
+bool IsMoving() const {
+    return rotate_velocity[0] != 0 || rotate_velocity[1] != 0 || translate_velocity[0] != 0 ||
+        translate_velocity[1] != 0 || zoom_velocity != 0;
+}
+
+// Moves arc by the Fixed Steps That Fit in elapsed Seconds Plus Time Left
+// Over From Earlier Calls. Velocities Slower Than rest_speed Stop, so the
+// Camera (and its Version()) Comes to Rest. Math is Passed to Rotate()
+template<typename Math = math_precise, typename A>
+void Update(A &arc, const float elapsed){
+    if(!IsMoving()){
+        accumulator = 0;
+        return;
+    }
+    float steps, gain, decay, lag;
+    if(!InertiaSteps(time_step, damping, elapsed, accumulator, steps, gain, decay, lag)){return;}
+
+    arc.template Rotate<Math>(rotate_velocity[0]*gain, rotate_velocity[1]*gain);
+    arc.Translate(translate_velocity[0]*gain, translate_velocity[1]*gain);
+    if(zoom_velocity != 0){
+        float scale = InertiaZoomMouseScale(steps, lag, arc.zoom_sensitivity*zoom_velocity, arc.Radius());
+        arc.Zoom(zoom_mouse[0]*scale, zoom_mouse[1]*scale, zoom_velocity*gain);
+    }
+
+    const float rest_speed2 = rest_speed*rest_speed;
+    for(int i=0; i<2; i++){
+        rotate_velocity[i] *= decay;
+        translate_velocity[i] *= decay;
+    }
+    zoom_velocity *= decay;
+    if(DotVec<2>(rotate_velocity, rotate_velocity) < rest_speed2){rotate_velocity[0] = rotate_velocity[1] = 0;}
+    if(DotVec<2>(translate_velocity, translate_velocity) < rest_speed2){translate_velocity[0] = translate_velocity[1] = 0;}
+    if(zoom_velocity*zoom_velocity < rest_speed2){zoom_velocity = 0;}
+}
+
+// Seconds per Integration Step
+float time_step = 1.0f/120;
+
+// Velocity Decays by e^-damping per Second
+float damping = 5;
+
+// Velocities Below This (Deltas per Second) Stop
+float rest_speed = 1;
+
+float rotate_velocity[2] = {0, 0};
+
+float translate_velocity[2] = {0, 0};
+
+float zoom_velocity = 0;
+
+float zoom_mouse[2] = {0, 0};
+
+private:
+
+// Time Not Yet Run as a Whole Step
+float accumulator = 0;
+
+};
+
+
+// arcball_inertia for Every Camera in an arcball_batch, Stored as Separate
+// Arrays. All Cameras Share One Clock, time_step and damping, so a Frame
+// Works Out the Closed Form Once and Scales Each Camera's Velocity by it
+struct arcball_inertia_batch{
+
+// Member Functions
+
+size_t Size() const {return zoom_velocity.size();}
+
+// New Cameras Start at Rest
+void Resize(const size_t size){
+    for(int i=0; i<2; i++){
+        rotate_velocity[i].resize(size, 0);
+        translate_velocity[i].resize(size, 0);
+        zoom_mouse[i].resize(size, 0);
+    }
+    zoom_velocity.resize(size, 0);
+}
+
+void AddRotate(const size_t index, const float velocity_x, const float velocity_y){
+    rotate_velocity[0][index] += velocity_x;
+    rotate_velocity[1][index] += velocity_y;
+}
+
+void AddTranslate(const size_t index, const float velocity_x, const float velocity_y){
+    translate_velocity[0][index] += velocity_x;
+    translate_velocity[1][index] += velocity_y;
+}
+
+void AddZoom(const size_t index, const float mouse_x, const float mouse_y, const float velocity){
+    zoom_mouse[0][index] = mouse_x;
+    zoom_mouse[1][index] = mouse_y;
+    zoom_velocity[index] += velocity;
+}
+
+void Stop(const size_t index){
+    for(int i=0; i<2; i++){
+        rotate_velocity[i][index] = 0;
+        translate_velocity[i][index] = 0;
+    }
+    zoom_velocity[index] = 0;
+}
+
+// Queues Each Camera's Deltas for the Fixed Steps That Fit in elapsed
+// Seconds Into batch, Which Must be the Same Size, Then Decays the
+// Velocities Like arcball_inertia::Update(). Call batch.Update() After
+void Update(arcball_batch &batch, const float elapsed){
+    if(batch.Size() != Size()){AGP_THROW("Batch Size Mismatch");}
+    float steps, gain, decay, lag;
+    if(!InertiaSteps(time_step, damping, elapsed, accumulator, steps, gain, decay, lag)){return;}
+
+    for(size_t i=0; i<Size(); i++){
+        batch.QueueRotate(i, rotate_velocity[0][i]*gain, rotate_velocity[1][i]*gain);
+        batch.QueueTranslate(i, translate_velocity[0][i]*gain, translate_velocity[1][i]*gain);
+        if(zoom_velocity[i] != 0){
+            float scale = InertiaZoomMouseScale(steps, lag, batch.zoom_sensitivity[i]*zoom_velocity[i],
+                batch.radius[i]);
+            batch.QueueZoom(i, zoom_mouse[0][i]*scale, zoom_mouse[1][i]*scale, zoom_velocity[i]*gain);
+        }
+    }
+    Decay(decay, rotate_velocity[0].data(), rotate_velocity[1].data());
+    Decay(decay, translate_velocity[0].data(), translate_velocity[1].data());
+    Decay(decay, zoom_velocity.data());
+}
+
+// Seconds per Integration Step
+float time_step = 1.0f/120;
+
+// Velocity Decays by e^-damping per Second
+float damping = 5;
+
+// Velocities Below This (Deltas per Second) Stop
+float rest_speed = 1;
+
+
+private:
+
+// Scales 2D Velocities by decay, Zeroing Those Slower Than rest_speed.
+// Branchless so it Vectorizes
+void Decay(const float decay, float * __restrict__ x, float * __restrict__ y){
+    const float rest_speed2 = rest_speed*rest_speed;
+    for(size_t i=0; i<Size(); i++){
+        float velocity_x = x[i]*decay;
+        float velocity_y = y[i]*decay;
+        bool is_moving = velocity_x*velocity_x + velocity_y*velocity_y >= rest_speed2;
+        x[i] = is_moving ? velocity_x : 0;
+        y[i] = is_moving ? velocity_y : 0;
+    }
+}
+
+// Same as Above for 1D Velocities
+void Decay(const float decay, float * __restrict__ x){
+    const float rest_speed2 = rest_speed*rest_speed;
+    for(size_t i=0; i<Size(); i++){
+        float velocity = x[i]*decay;
+        x[i] = velocity*velocity >= rest_speed2 ? velocity : 0;
+    }
+}
+
+std::vector<float> rotate_velocity[2];
+
+std::vector<float> translate_velocity[2];
+
+std::vector<float> zoom_velocity;
+
+std::vector<float> zoom_mouse[2];
+
+// Time Not Yet Run as a Whole Step
+float accumulator = 0;
+
+};
+
+
+
+// Math Picks the 1/sqrt, sin and cos Used by operator*, SetWithEuler() and
+// nlerp(), e.g. quaternion<float, math_fast>
+template <typename T, typename Math = math_precise> class quaternion{
+
+T quat[4] = {1,0,0,0};
+
+public:
+
+
+// Constructors
+constexpr quaternion(){};
+
+quaternion(std::initializer_list<T> init){
+    std::copy(init.begin(), init.end(), quat);
+    Normalize();
+};
+
+
+// Copy Constructor
+constexpr quaternion(const quaternion &q2) : quat{q2.quat[0], q2.quat[1], q2.quat[2], q2.quat[3]} {}
+
+
+// Compile Time Constructors, Usable in constexpr
+
+// Normalizes w, x, y, z
+static constexpr quaternion FromValues(const T w, const T x, const T y, const T z){
+    return quaternion(w, x, y, z, (T)(1/ConstSqrt((double)w*w + (double)x*x + (double)y*y + (double)z*z)));
+}
+
+// Same as SetWithEuler()
+static constexpr quaternion FromEuler(const double roll/*x*/, const double pitch/*y*/, const double yaw/*z*/){
+    return FromHalfAngles(ConstCos(0.5*roll), ConstSin(0.5*roll), ConstCos(0.5*pitch),
+        ConstSin(0.5*pitch), ConstCos(0.5*yaw), ConstSin(0.5*yaw));
+}
+
+
+// Operators
+T& operator[] (int pos){
+    if(pos < 0 || pos > 3){ThrowOnError(status_index_out_of_bounds);}
+    return quat[pos];
+}
+
+// Same as operator[] but Copies Element pos to value and Returns
+// status_index_out_of_bounds Instead of Throwing, or With error_clamp
+// Reads the Nearest Element
+template<typename Policy = error_report>
+agp_status TryGet(int pos, T &value) const noexcept {
+    if(pos < 0 || pos > 3){
+        if(!Policy::is_clamped){return status_index_out_of_bounds;}
+        pos = pos < 0 ? 0 : 3;
+    }
+    value = quat[pos];
+    return status_ok;
+}
+
+void operator= (const quaternion &q2){
+    std::copy(q2.quat, q2.quat + 4, quat);
+}
+    
+
+// Ostream Print
+friend std::ostream& operator<< (std::ostream& os, const quaternion& qt){
+    os<<"["<<qt.quat[0]<<", "<<qt.quat[1]<<", "<<qt.quat[2]<<", "<<qt.quat[3]<<"]";
+    return os;
+}
+
+
+// Member Functions
+
+// q_return = q1 * q2
+quaternion operator* (const quaternion &q2){
+    AGP_TRACE_SCOPE("quaternion::operator*");
+    quaternion return_quat;
+    return_quat.quat[0] = quat[0]*q2.quat[0] - quat[1]*q2.quat[1] - quat[2]*q2.quat[2] - quat[3]*q2.quat[3];
+    return_quat.quat[1] = quat[0]*q2.quat[1] + quat[1]*q2.quat[0] + quat[2]*q2.quat[3] - quat[3]*q2.quat[2];
+    return_quat.quat[2] = quat[0]*q2.quat[2] - quat[1]*q2.quat[3] + quat[2]*q2.quat[0] + quat[3]*q2.quat[1];
+    return_quat.quat[3] = quat[0]*q2.quat[3] + quat[1]*q2.quat[2] - quat[2]*q2.quat[1] + quat[3]*q2.quat[0];
+
+    return_quat.Normalize();
+    return return_quat;
+}
+
+// Returns Pointer To Quat Array
+T* RawData(){
+    return this->quat;
+}
+
+constexpr const T* RawData() const {
+    return quat;
+}
+
+quaternion & Conj(){
+    for(int i=1; i<4; i++){
+        quat[i] = -quat[i];
+    }
+    return *this;
+}
+
+void Rotate(float *vec){
+    float q[3] = {(float)quat[1], (float)quat[2], (float)quat[3]};
+    float qcrossr[3];
+    float qright[3];
+
+    CrossVec(q, vec, qcrossr);
+
+    for(int i=0; i<3; i++){
+        q[i] = 2*q[i];
+    }
+    CrossVec(q, qcrossr, qright);
+
+    for(int i=0; i<3; i++){
+        vec[i] += 2*quat[0]*qcrossr[i] + qright[i];
+    }
+
+}
+
+
+// Returns 4x4 Rotation Matrix
+void RotationMatrix4(T *matrix){
+    
+    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
+    matrix[1] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
+    matrix[2] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
+    matrix[3] = 0;
+    matrix[4] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
+    matrix[5] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
+    matrix[6] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
+    matrix[7] = 0;
+    matrix[8] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
+    matrix[9] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
+    matrix[10] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
+    matrix[11] = 0;
+    matrix[12] = 0;
+    matrix[13] = 0;
+    matrix[14] = 0;
+    matrix[15] = 1; // 3, 3
+}
+
+// Returns 4x4 Rotation Matrix Transposed
+void RotationMatrix4T(T *matrix){
+
+    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
+    matrix[1] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
+    matrix[2] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
+    matrix[3] = 0;
+    matrix[4] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
+    matrix[5] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
+    matrix[6] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
+    matrix[7] = 0;
+    matrix[8] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
+    matrix[9] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
+    matrix[10] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
+    matrix[11] = 0;
+    matrix[12] = 0;
+    matrix[13] = 0;
+    matrix[14] = 0;
+    matrix[15] = 1; // 3, 3
+}
+
+// Writes the 4x4 Rotation Matrix in layout Straight Into matrix, e.g. a
+// Mapped Uniform Buffer. See StoreMat4()
+void RotationMatrix4(T *matrix, const matrix_layout layout, const bool is_streamed = false){
+    T rotation[16];
+    RotationMatrix4(rotation);
+    StoreMat4(rotation, matrix, layout, is_streamed);
+    if(is_streamed){StoreFence();}
+}
+
+// Returns 3x3 Rotation Matrix
+void RotationMatrix3(T *matrix){
+
+
+    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
+    matrix[1] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
+    matrix[2] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
+    matrix[3] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
+    matrix[4] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
+    matrix[5] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
+    matrix[6] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
+    matrix[7] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
+    matrix[8] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
+}
+
+// Returns 3x3 Rotation Matrix Transposed
+void RotationMatrix3T(T *matrix){
+
+    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
+    matrix[1] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
+    matrix[2] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
+    matrix[3] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
+    matrix[4] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
+    matrix[5] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
+    matrix[6] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
+    matrix[7] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
+    matrix[8] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
+}
+
+
+// Sets Quaternion With Euler Angles
+// Angles must be in radians
+// NASA ZYX Rotation Order
+void SetWithEuler(float roll/*x*/, float pitch/*y*/, float yaw/*z*/){
+    AGP_TRACE_SCOPE("quaternion::SetWithEuler");
+    T cos_z = Math::Cos(0.5*yaw);
+    T sin_z = Math::Sin(0.5*yaw);
+    T cos_y = Math::Cos(0.5*pitch);
+    T sin_y = Math::Sin(0.5*pitch);
+    T cos_x = Math::Cos(0.5*roll);
+    T sin_x = Math::Sin(0.5*roll);
+
+    T cxcy = cos_x * cos_y;
+    T sxsy = sin_x * sin_y;
+    T sxcy = sin_x * cos_y;
+    T cxsy = cos_x * sin_y;
+
+    quat[0] = cxcy * cos_z + sxsy * sin_z;
+    quat[1] = sxcy * cos_z - cxsy * sin_z;
+    quat[2] = cxsy * cos_z + sxcy * sin_z;
+    quat[3] = cxcy * sin_z - sxsy * cos_z;
+
+    // Normalization
+    Normalize();
+}
+
+// Angles must be in radians
+// NASA ZYX Rotation Order
+void Euler(float *output){
+
+	T cross = quat[0]*quat[2] - quat[3]*quat[1];
+
+    // Aligned With Positive Z-axis
+	if(cross > 0.49999){
+        output[0] = 2*atan2(quat[1], quat[0]);
+		output[1] = 1.57079632679;
+		output[2] = 0;
+		return;
+	}
+
+    // Aligned With Negative Z-axis
+	else if(cross < -0.49999){
+        output[0] = 2*atan2(quat[1], quat[0]);
+		output[1] = -1.57079632679;
+		output[2] = 0;
+		return;
+	}
+    
+    else{
+        output[0] = atan2(2*(quat[0]*quat[1] + quat[2]*quat[3]) , 1 - 2*(quat[1]*quat[1] + quat[2]*quat[2]));
+        output[1] = asin(2*cross);
+        output[2] = atan2(2*(quat[0]*quat[3] + quat[1]*quat[2]) , 1 - 2*(quat[2]*quat[2] + quat[3]*quat[3]));
+        return;
+    }
+}
+
+
+// returns nlerp Quaternion From q1 To q2 by Percentage t Between 0 and 1
+void nlerp(quaternion &q1, quaternion &q2, float t){
+    ThrowOnError(TryNlerp(q1, q2, t));
+}
+
+// Same as nlerp() but Returns status_percentage_out_of_bounds or
+// status_nlerp_undefined Instead of Throwing. With error_clamp t is
+// Clamped to [0, 1]; q1 and q2 180 Degrees Apart Still Report
+template<typename Policy = error_report>
+agp_status TryNlerp(const quaternion &q1, const quaternion &q2, float t) noexcept {
+
+        if(t < 0 || t > 1){
+            if(!Policy::is_clamped){return status_percentage_out_of_bounds;}
+            t = t < 0 ? 0 : 1;
+        }
+
+        float angle = 0;
+        for(int i=0; i<4; i++){
+            angle += q1.quat[i]*q2.quat[i];
+        }
+
+        if(angle < 0.0){
+            if(angle < -0.999){return status_nlerp_undefined;}
+            for(int i=0; i<4; i++){
+                quat[i] = q1.quat[i] - t*(q1.quat[i] + q2.quat[i]);
+            }
+        }
+        else{
+            for(int i=0; i<4; i++){
+                quat[i] = q1.quat[i] - t*(q1.quat[i] - q2.quat[i]);
+            }
+        }
+        
+        Normalize();
+        return status_ok;
+}
+
+
+private: 
+
+constexpr quaternion(const T w, const T x, const T y, const T z, const T scale)
+: quat{w*scale, x*scale, y*scale, z*scale} {}
+
+static constexpr quaternion FromHalfAngles(const double cos_x, const double sin_x, const double cos_y,
+const double sin_y, const double cos_z, const double sin_z){
+    return FromValues(cos_x*cos_y*cos_z + sin_x*sin_y*sin_z, sin_x*cos_y*cos_z - cos_x*sin_y*sin_z,
+        cos_x*sin_y*cos_z + sin_x*cos_y*sin_z, cos_x*cos_y*sin_z - sin_x*sin_y*cos_z);
+}
+
+// Normalize Internal Quat Array
+void Normalize(){
+    T magnitude = 0;
+    for (int i=0; i<4; i++){
+        magnitude += quat[i]*quat[i];
+    }
+    magnitude = Math::RSqrt(magnitude);
+    for (int i=0; i<4; i++){
+        quat[i] = quat[i]*magnitude;
+    }
+}
+
+};
+
+
+// arcball That Keeps its Orientation as a Unit Quaternion. A Rotate() is One
+// quaternion Multiply and the Basis is the Rotation Matrix, so the Frame
+// Stays Orthonormal and the Up Vector Never Drifts. Controls Match arcball,
+// Except Rotations are Exact Where arcball Updates the Up Vector to First Order
+struct quaternion_arcball : arcball_view<quaternion_arcball>{
+
+void SetCamera(const float *cam_pos, const float *up){
+    AGP_TRACE_SCOPE("quaternion_arcball::SetCamera");
+    ThrowOnError(TrySetCamera(cam_pos, up));
+}
+
+// Same as SetCamera() but Returns status_camera_at_center or
+// status_parallel_vectors Instead of Throwing
+agp_status TrySetCamera(const float *cam_pos, const float *up) noexcept {
+    float dir_vec[3];
+    DiffVec<3>(cam_pos, center_pos, dir_vec);
+    float distance = MagnitudeVec<3>(dir_vec);
+    if(distance == 0){return status_camera_at_center;}
+    quaternion<float> turned;
+    agp_status status = LookAlong(dir_vec, up, turned);
+    if(status != status_ok){return status;}
+    orientation = turned;
+    radius = distance;
+    ViewChanged();
+    return status_ok;
+}
+
+// Keeps the Camera Where it is and Turns it to Face the New Center
+void SetCenter(const float *input){
+    ThrowOnError(TrySetCenter(input));
+}
+
+// Same as SetCenter() but Returns status_camera_at_center or
+// status_parallel_vectors Instead of Throwing, Leaving the View As it Was.
+// With error_clamp a Center in Line With the Up Vector Pitches the Camera
+// Straight Toward it Instead, Keeping the Right Vector
+template<typename Policy = error_report>
+agp_status TrySetCenter(const float *input) noexcept {
+    UpdateBasis();
+    float dir_vec[3];
+    DiffVec<3>(camera_pos, input, dir_vec);
+    float distance = MagnitudeVec<3>(dir_vec);
+    if(distance == 0){return status_camera_at_center;}
+    quaternion<float> turned;
+    agp_status status = LookAlong(dir_vec, basis + 3, turned);
+    if(status == status_parallel_vectors && Policy::is_clamped){
+        // The Back Vector Pitched the Same Way Becomes the Up Vector
+        float sign = DotVec<3>(dir_vec, basis + 3) > 0 ? -1 : 1;
+        float up[3] = {sign*basis[6], sign*basis[7], sign*basis[8]};
+        status = LookAlong(dir_vec, up, turned);
+    }
+    if(status != status_ok){return status;}
+    std::copy(input, input + 3, center_pos);
+    orientation = turned;
+    radius = distance;
+    ViewChanged();
+    return status_ok;
+}
+
+void SetOrientation(const quaternion<float> &input){
+    orientation = input;
+    ViewChanged();
+}
+
+const quaternion<float> &Orientation() const {return orientation;}
+
+const float *Camera(){
+    UpdateBasis();
+    return camera_pos;
+}
+
+// The Equivalent arcball State, for arcball_recorder and arcball_replay
+void GetState(arcball_state &state){
+    UpdateBasis();
+    GetViewState(state);
+    std::copy(basis + 3, basis + 6, state.up_vec);
+    std::copy(basis + 6, basis + 9, state.back_vec);
+}
+
+// Turns About the Local Axis (-delta_y, -delta_x, 0) by rotate_sensitivity
+// Times the Delta's Length, Appended to the Orientation as One Multiply
+template<typename Math = math_precise>
+void Rotate(const float delta_x, const float delta_y){
+    AGP_TRACE_SCOPE("quaternion_arcball::Rotate");
+    if(delta_x == 0 && delta_y == 0){return;}
+    float magnitude = Math::Sqrt(delta_x*delta_x + delta_y*delta_y);
+    float half_theta = 0.5f*rotate_sensitivity*magnitude;
+    float sine = Math::Sin(half_theta)/magnitude;
+    quaternion<float> step;
+    step[0] = Math::Cos(half_theta);
+    step[1] = -delta_y*sine;
+    step[2] = -delta_x*sine;
+    step[3] = 0;
+    orientation = orientation*step;
+    ViewChanged();
+}
+
+
+private:
+
+friend struct arcball_view<quaternion_arcball>;
+
+static constexpr const char *translate_trace = "quaternion_arcball::Translate";
+
+static constexpr const char *zoom_trace = "quaternion_arcball::Zoom";
+
+static constexpr const char *view_proj_trace = "quaternion_arcball::ViewProjMatrix";
+
+static constexpr const char *depth_points_trace = "quaternion_arcball::DepthPoints";
+
+// Writes to result the Orientation Whose Back Axis is dir_vec and Whose Up
+// Axis is up Made Perpendicular to it. Columns of the Rotation are the
+// Right, Up and Back Vectors, Converted to a Quaternion by Shepperd's Method
+agp_status LookAlong(const float *dir_vec, const float *up, quaternion<float> &result) noexcept {
+    float back[3] = {dir_vec[0], dir_vec[1], dir_vec[2]};
+    NormalizeVec<3>(back);
+    float up_magnitude = MagnitudeVec<3>(up);
+    if(up_magnitude == 0 || fabs(DotVec<3>(back, up)) >= 0.999*up_magnitude){
+        return status_parallel_vectors;
+    }
+    float right[3];
+    float up_vec[3];
+    CrossVec(up, back, right);
+    NormalizeVec<3>(right);
+    CrossVec(back, right, up_vec);
+
+    float trace = right[0] + up_vec[1] + back[2];
+    float w, x, y, z;
+    if(trace > 0){
+        float s = 0.5f/sqrt(trace + 1);
+        w = 0.25f/s;
+        x = (up_vec[2] - back[1])*s;
+        y = (back[0] - right[2])*s;
+        z = (right[1] - up_vec[0])*s;
+    }
+    else if(right[0] > up_vec[1] && right[0] > back[2]){
+        float s = 2*sqrt(1 + right[0] - up_vec[1] - back[2]);
+        w = (up_vec[2] - back[1])/s;
+        x = 0.25f*s;
+        y = (up_vec[0] + right[1])/s;
+        z = (back[0] + right[2])/s;
+    }
+    else if(up_vec[1] > back[2]){
+        float s = 2*sqrt(1 + up_vec[1] - right[0] - back[2]);
+        w = (back[0] - right[2])/s;
+        x = (up_vec[0] + right[1])/s;
+        y = 0.25f*s;
+        z = (back[1] + up_vec[2])/s;
+    }
+    else{
+        float s = 2*sqrt(1 + back[2] - right[0] - up_vec[1]);
+        w = (right[1] - up_vec[0])/s;
+        x = (back[0] + right[2])/s;
+        y = (back[1] + up_vec[2])/s;
+        z = 0.25f*s;
+    }
+    result = quaternion<float>({w, x, y, z});
+    return status_ok;
+}
+
+// The Camera Follows the Orientation, so it is Formed With the Basis
+void FormBasis(){
+    orientation.RotationMatrix3T(basis);
+    PlaceCamera();
+}
+
+void PlaceCamera(){
+    for(int i=0; i<3; i++){
+        camera_pos[i] = center_pos[i] + radius*basis[i + 6];
+    }
+}
+
+// Same Default View as arcball, Camera on +y With +z Up
+quaternion<float> orientation = quaternion<float>::FromValues(0, 0, 1, 1);
+
+};
+
+
+// Structure of Arrays Quaternion Container. Each Batch Operation Performs
+// the Same Arithmetic in the Same Order as the Matching quaternion Member
+// Function, so Results are Bit for Bit the Same as Looping Over quaternion
+// Objects Unless the Compiler Fuses Multiply-Adds Differently in the Two
+// (e.g. -march With FMA)
+template <typename T> class quaternion_array{
+
+public:
+
+// Constructors
+quaternion_array(){};
+
+// Filled With Identity Quaternions
+explicit quaternion_array(const size_t size){
+    Resize(size);
+};
+
+
+// Member Functions
+
+size_t Size() const {return quat[0].size();}
+
+// New Elements are Identity Quaternions
+void Resize(const size_t size){
+    quat[0].resize(size, 1);
+    for(int i=1; i<4; i++){
+        quat[i].resize(size, 0);
+    }
+}
+
+void Set(const size_t index, const quaternion<T> &q){
+    const T *data = q.RawData();
+    for(int i=0; i<4; i++){
+        quat[i][index] = data[i];
+    }
+}
+
+quaternion<T> Get(const size_t index) const {
+    quaternion<T> return_quat;
+    T *data = return_quat.RawData();
+    for(int i=0; i<4; i++){
+        data[i] = quat[i][index];
+    }
+    return return_quat;
+}
+
+// Returns Pointer to Component Array. Component Order: w, x, y, z
+T* RawData(const int component){
+    return quat[component].data();
+}
+
+const T* RawData(const int component) const {
+    return quat[component].data();
+}
+
+// this[i] = q1[i] * q2[i]. Either Input May be this
+void Multiply(const quaternion_array &q1, const quaternion_array &q2){
+    AGP_TRACE_SCOPE("quaternion_array::Multiply");
+    if(q2.Size() != q1.Size()){ThrowOnError(status_size_mismatch);}
+    Resize(q1.Size());
+    struct multiply_kernel{
+        const quaternion_array &q1;
+        const quaternion_array &q2;
+        void operator()(const size_t begin, const size_t count, T *w, T *x, T *y, T *z) const {
+            MultiplyKernel(q1.quat[0].data() + begin, q1.quat[1].data() + begin, q1.quat[2].data() + begin,
+                q1.quat[3].data() + begin, q2.quat[0].data() + begin, q2.quat[1].data() + begin,
+                q2.quat[2].data() + begin, q2.quat[3].data() + begin, count, w, x, y, z);
+        }
+    } kernel = {q1, q2};
+    WriteQuats(&q1 == this || &q2 == this, kernel);
+}
+
+// this[i] = q1[i] * q2, e.g. Every Orientation Times One Offset. q1 May be this
+void Multiply(const quaternion_array &q1, const quaternion<T> &q2){
+    AGP_TRACE_SCOPE("quaternion_array::Multiply");
+    Resize(q1.Size());
+    struct multiply_kernel{
+        const quaternion_array &q1;
+        const T *b;
+        void operator()(const size_t begin, const size_t count, T *w, T *x, T *y, T *z) const {
+            MultiplyKernel(q1.quat[0].data() + begin, q1.quat[1].data() + begin, q1.quat[2].data() + begin,
+                q1.quat[3].data() + begin, b, count, w, x, y, z);
+        }
+    } kernel = {q1, q2.RawData()};
+    WriteQuats(&q1 == this, kernel);
+}
+
+quaternion_array & Conj(){
+    for(int i=1; i<4; i++){
+        T * __restrict__ component = quat[i].data();
+        for(size_t j=0; j<Size(); j++){
+            component[j] = -component[j];
+        }
+    }
+    return *this;
+}
+
+// Rotates Point i, Stored in x[i], y[i], z[i], by Quaternion i
+void Rotate(float * __restrict__ x, float * __restrict__ y, float * __restrict__ z) const {
+    RotateRange(x, y, z, 0, Size());
+}
+
+// Same as Rotate() Split Across pool
+void Rotate(float *x, float *y, float *z, thread_pool &pool) const {
+    struct rotate_job{
+        const quaternion_array &quats;
+        float *x;
+        float *y;
+        float *z;
+        void operator()(const size_t begin, const size_t end){
+            quats.RotateRange(x, y, z, begin, end);
+        }
+    } job = {*this, x, y, z};
+    pool.ParallelFor(Size(), quat_chunk_size, job);
+}
+
+// Writes Size() 4x4 Rotation Matrices Contiguously to matrices
+void RotationMatrix4(T * __restrict__ matrices) const {
+    AGP_TRACE_SCOPE("quaternion_array::RotationMatrix4");
+    WriteMatrices<4, false>(matrices, 0, Size(), 4*4, false);
+}
+
+// Writes Size() 4x4 Rotation Matrices Transposed Contiguously to matrices
+void RotationMatrix4T(T * __restrict__ matrices) const {
+    WriteMatrices<4, true>(matrices, 0, Size(), 4*4, false);
+}
+
+// Writes Matrix i in layout to matrices + i*stride, e.g. Straight Into a
+// Mapped Instance Buffer. column_major is the Same as RotationMatrix4T().
+// See StoreMat4()
+void RotationMatrix4(T *matrices, const size_t stride, const matrix_layout layout, const bool is_streamed = false) const {
+    AGP_TRACE_SCOPE("quaternion_array::RotationMatrix4");
+    if(layout == column_major){WriteMatrices<4, true>(matrices, 0, Size(), stride, is_streamed);}
+    else{WriteMatrices<4, false>(matrices, 0, Size(), stride, is_streamed);}
+    if(is_streamed){StoreFence();}
+}
+
+// Same as RotationMatrix4() Split Across pool
+void RotationMatrix4(T *matrices, thread_pool &pool) const {
+    AGP_TRACE_SCOPE("quaternion_array::RotationMatrix4");
+    WriteMatricesParallel<4, false>(matrices, pool);
+}
+
+// Same as RotationMatrix4T() Split Across pool
+void RotationMatrix4T(T *matrices, thread_pool &pool) const {
+    WriteMatricesParallel<4, true>(matrices, pool);
+}
+
+// Writes Size() 3x3 Rotation Matrices Contiguously to matrices
+void RotationMatrix3(T * __restrict__ matrices) const {
+    WriteMatrices<3, false>(matrices, 0, Size(), 3*3, false);
+}
+
+// Writes Size() 3x3 Rotation Matrices Transposed Contiguously to matrices
+void RotationMatrix3T(T * __restrict__ matrices) const {
+    WriteMatrices<3, true>(matrices, 0, Size(), 3*3, false);
+}
+
+// this[i] = nlerp Quaternion From q1[i] To q2[i] by Percentage t Between 0
+// and 1. Either Input May be this
+void nlerp(const quaternion_array &q1, const quaternion_array &q2, float t){
+    AGP_TRACE_SCOPE("quaternion_array::nlerp");
+    agp_status status = TryNlerp(q1, q2, t);
+    if(status == status_size_mismatch && q2.Size() == q1.Size()){
+        Resize(q1.Size());
+        status = TryNlerp(q1, q2, t);
+    }
+    ThrowOnError(status);
+}
+
+// Same as nlerp() but Returns status_percentage_out_of_bounds or
+// status_nlerp_undefined Instead of Throwing. With error_clamp t is
+// Clamped to [0, 1]. Never Allocates, so q2 and this Must Already Have
+// q1.Size() Quaternions, Otherwise it Returns status_size_mismatch
+template<typename Policy = error_report>
+agp_status TryNlerp(const quaternion_array &q1, const quaternion_array &q2, float t) noexcept {
+    // Checked Before Anything is Read
+    if(q2.Size() != q1.Size() || Size() != q1.Size()){return status_size_mismatch;}
+    if(t < 0 || t > 1){
+        if(!Policy::is_clamped){return status_percentage_out_of_bounds;}
+        t = t < 0 ? 0 : 1;
+    }
+
+    const T * __restrict__ a0 = q1.quat[0].data();
+    const T * __restrict__ a1 = q1.quat[1].data();
+    const T * __restrict__ a2 = q1.quat[2].data();
+    const T * __restrict__ a3 = q1.quat[3].data();
+    const T * __restrict__ b0 = q2.quat[0].data();
+    const T * __restrict__ b1 = q2.quat[1].data();
+    const T * __restrict__ b2 = q2.quat[2].data();
+    const T * __restrict__ b3 = q2.quat[3].data();
+
+    // Checked Up Front so Nothing is Written When an Error is Returned
+    bool is_undefined = false;
+    for(size_t i=0; i<q1.Size(); i++){
+        float angle = 0;
+        angle += a0[i]*b0[i];
+        angle += a1[i]*b1[i];
+        angle += a2[i]*b2[i];
+        angle += a3[i]*b3[i];
+        is_undefined = is_undefined || angle < -0.999;
+    }
+    if(is_undefined){return status_nlerp_undefined;}
+
+    struct nlerp_kernel{
+        const quaternion_array &q1;
+        const quaternion_array &q2;
+        float t;
+        void operator()(const size_t begin, const size_t count, T *w, T *x, T *y, T *z) const {
+            NlerpKernel(q1.quat[0].data() + begin, q1.quat[1].data() + begin, q1.quat[2].data() + begin,
+                q1.quat[3].data() + begin, q2.quat[0].data() + begin, q2.quat[1].data() + begin,
+                q2.quat[2].data() + begin, q2.quat[3].data() + begin, t, count, w, x, y, z);
+        }
+    } kernel = {q1, q2, t};
+    WriteQuats(&q1 == this || &q2 == this, kernel);
+    return status_ok;
+}
+
+
+// this[i] = Quaternion of Euler Angles roll[i], pitch[i], yaw[i], in
+// Radians, NASA ZYX Order Like quaternion::SetWithEuler. Vectorized math_fast
+// Polynomials Instead of sin and cos, so Results are Within About 3e-7 of
+// SetWithEuler Rather Than Equal. Split Across pool
+void SetWithEuler(const float *roll, const float *pitch, const float *yaw, const size_t count,
+thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE("quaternion_array::SetWithEuler");
+    Resize(count);
+    struct euler_job{
+        const float *roll;
+        const float *pitch;
+        const float *yaw;
+        T *quat[4];
+        void operator()(const size_t begin, const size_t end){
+            FromEulerSerial(roll + begin, pitch + begin, yaw + begin, quat[0] + begin,
+                quat[1] + begin, quat[2] + begin, quat[3] + begin, end - begin);
+        }
+    } job = {roll, pitch, yaw, {quat[0].data(), quat[1].data(), quat[2].data(), quat[3].data()}};
+    pool.ParallelFor(count, euler_chunk_size, job);
+}
+
+// Writes Size() Euler Angles, Like quaternion::Euler Including its Handling
+// of the Poles, Which is Done With Selects Instead of Branches. Within About
+// 1e-6 Radians of Euler Away From the Poles; Near Them Both are Limited by
+// the Precision of asin. Compile With -fno-math-errno so the sqrt
+// Vectorizes. Split Across pool
+void Euler(float *roll, float *pitch, float *yaw, thread_pool &pool = DefaultThreadPool()) const {
+    AGP_TRACE_SCOPE("quaternion_array::Euler");
+    struct euler_job{
+        const T *quat[4];
+        float *roll;
+        float *pitch;
+        float *yaw;
+        void operator()(const size_t begin, const size_t end){
+            ToEulerSerial(quat[0] + begin, quat[1] + begin, quat[2] + begin, quat[3] + begin,
+                roll + begin, pitch + begin, yaw + begin, end - begin);
+        }
+    } job = {{quat[0].data(), quat[1].data(), quat[2].data(), quat[3].data()}, roll, pitch, yaw};
+    pool.ParallelFor(Size(), euler_chunk_size, job);
+}
+
+
+private:
+
+// Samples per Parallel Chunk for the Euler Conversions
+static const size_t euler_chunk_size = 16384;
+
+// Quaternions per Parallel Chunk for Matrices and Point Rotation, About
+// 64 KB of Float Matrices
+static const size_t quat_chunk_size = 1024;
+
+// Quaternions per Stack Tile When the Output is Also an Input
+static const size_t alias_tile_size = 256;
+
+// Runs kernel(begin, count, w, x, y, z) Over Every Quaternion. The Kernels
+// Take __restrict__ Pointers, so When this is Also an Input Each Tile is
+// Written to the Stack First and Copied Over After
+template<typename F>
+void WriteQuats(const bool is_aliased, const F &kernel){
+    if(!is_aliased){
+        kernel(0, Size(), quat[0].data(), quat[1].data(), quat[2].data(), quat[3].data());
+        return;
+    }
+    T tile[4][alias_tile_size];
+    for(size_t begin=0; begin<Size(); begin+=alias_tile_size){
+        size_t count = std::min(alias_tile_size, Size() - begin);
+        kernel(begin, count, tile[0], tile[1], tile[2], tile[3]);
+        for(int i=0; i<4; i++){
+            std::copy(tile[i], tile[i] + count, quat[i].data() + begin);
+        }
+    }
+}
+
+static void MultiplyKernel(const T * __restrict__ a0, const T * __restrict__ a1, const T * __restrict__ a2,
+const T * __restrict__ a3, const T * __restrict__ b0, const T * __restrict__ b1, const T * __restrict__ b2,
+const T * __restrict__ b3, const size_t count, T * __restrict__ w, T * __restrict__ x, T * __restrict__ y,
+T * __restrict__ z){
+    for(size_t i=0; i<count; i++){
+        T r0 = a0[i]*b0[i] - a1[i]*b1[i] - a2[i]*b2[i] - a3[i]*b3[i];
+        T r1 = a0[i]*b1[i] + a1[i]*b0[i] + a2[i]*b3[i] - a3[i]*b2[i];
+        T r2 = a0[i]*b2[i] - a1[i]*b3[i] + a2[i]*b0[i] + a3[i]*b1[i];
+        T r3 = a0[i]*b3[i] + a1[i]*b2[i] - a2[i]*b1[i] + a3[i]*b0[i];
+        Normalize(r0, r1, r2, r3);
+        w[i] = r0;
+        x[i] = r1;
+        y[i] = r2;
+        z[i] = r3;
+    }
+}
+
+static void MultiplyKernel(const T * __restrict__ a0, const T * __restrict__ a1, const T * __restrict__ a2,
+const T * __restrict__ a3, const T *b, const size_t count, T * __restrict__ w, T * __restrict__ x,
+T * __restrict__ y, T * __restrict__ z){
+    const T b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+    for(size_t i=0; i<count; i++){
+        T r0 = a0[i]*b0 - a1[i]*b1 - a2[i]*b2 - a3[i]*b3;
+        T r1 = a0[i]*b1 + a1[i]*b0 + a2[i]*b3 - a3[i]*b2;
+        T r2 = a0[i]*b2 - a1[i]*b3 + a2[i]*b0 + a3[i]*b1;
+        T r3 = a0[i]*b3 + a1[i]*b2 - a2[i]*b1 + a3[i]*b0;
+        Normalize(r0, r1, r2, r3);
+        w[i] = r0;
+        x[i] = r1;
+        y[i] = r2;
+        z[i] = r3;
+    }
+}
+
+static void NlerpKernel(const T * __restrict__ a0, const T * __restrict__ a1, const T * __restrict__ a2,
+const T * __restrict__ a3, const T * __restrict__ b0, const T * __restrict__ b1, const T * __restrict__ b2,
+const T * __restrict__ b3, const float t, const size_t count, T * __restrict__ w, T * __restrict__ x,
+T * __restrict__ y, T * __restrict__ z){
+    for(size_t i=0; i<count; i++){
+        float angle = 0;
+        angle += a0[i]*b0[i];
+        angle += a1[i]*b1[i];
+        angle += a2[i]*b2[i];
+        angle += a3[i]*b3[i];
+
+        T r0, r1, r2, r3;
+        if(angle < 0.0){
+            r0 = a0[i] - t*(a0[i] + b0[i]);
+            r1 = a1[i] - t*(a1[i] + b1[i]);
+            r2 = a2[i] - t*(a2[i] + b2[i]);
+            r3 = a3[i] - t*(a3[i] + b3[i]);
+        }
+        else{
+            r0 = a0[i] - t*(a0[i] - b0[i]);
+            r1 = a1[i] - t*(a1[i] - b1[i]);
+            r2 = a2[i] - t*(a2[i] - b2[i]);
+            r3 = a3[i] - t*(a3[i] - b3[i]);
+        }
+        Normalize(r0, r1, r2, r3);
+        w[i] = r0;
+        x[i] = r1;
+        y[i] = r2;
+        z[i] = r3;
+    }
+}
+
+static void FromEulerSerial(const float * __restrict__ roll, const float * __restrict__ pitch,
+const float * __restrict__ yaw, T * __restrict__ w, T * __restrict__ x, T * __restrict__ y,
+T * __restrict__ z, const size_t count){
+    for(size_t i=0; i<count; i++){
+        T sin_x, cos_x, sin_y, cos_y, sin_z, cos_z;
+        math_fast::SinCos((T)(0.5f*roll[i]), sin_x, cos_x);
+        math_fast::SinCos((T)(0.5f*pitch[i]), sin_y, cos_y);
+        math_fast::SinCos((T)(0.5f*yaw[i]), sin_z, cos_z);
+
+        T cxcy = cos_x * cos_y;
+        T sxsy = sin_x * sin_y;
+        T sxcy = sin_x * cos_y;
+        T cxsy = cos_x * sin_y;
+
+        w[i] = cxcy * cos_z + sxsy * sin_z;
+        x[i] = sxcy * cos_z - cxsy * sin_z;
+        y[i] = cxsy * cos_z + sxcy * sin_z;
+        z[i] = cxcy * sin_z - sxsy * cos_z;
+    }
+}
+
+static void ToEulerSerial(const T * __restrict__ w, const T * __restrict__ x, const T * __restrict__ y,
+const T * __restrict__ z, float * __restrict__ roll, float * __restrict__ pitch,
+float * __restrict__ yaw, const size_t count){
+    for(size_t i=0; i<count; i++){
+        T cross = w[i]*y[i] - z[i]*x[i];
+        T sine = 2*cross;
+        sine = sine > 1 ? 1 : (sine < -1 ? -1 : sine);
+
+        T roll_value = math_fast::Atan2(2*(w[i]*x[i] + y[i]*z[i]), 1 - 2*(x[i]*x[i] + y[i]*y[i]));
+        T pitch_value = math_fast::Atan2(sine, (T)sqrt((1 - sine)*(1 + sine)));
+        T yaw_value = math_fast::Atan2(2*(w[i]*z[i] + x[i]*y[i]), 1 - 2*(y[i]*y[i] + z[i]*z[i]));
+
+        // Aligned With the Positive or Negative Z-axis
+        T pole_roll = 2*math_fast::Atan2(x[i], w[i]);
+        bool is_north = cross > (T)0.49999;
+        bool is_south = cross < -(T)0.49999;
+        bool is_pole = is_north || is_south;
+
+        roll[i] = (float)(is_pole ? pole_roll : roll_value);
+        pitch[i] = is_north ? 1.57079632679f : (is_south ? -1.57079632679f : (float)pitch_value);
+        yaw[i] = is_pole ? 0.0f : (float)yaw_value;
+    }
+}
+
+// Same Operations as quaternion::Normalize
+static void Normalize(T &q0, T &q1, T &q2, T &q3){
+    T magnitude = 0;
+    magnitude += q0*q0;
+    magnitude += q1*q1;
+    magnitude += q2*q2;
+    magnitude += q3*q3;
+    magnitude = 1/sqrt(magnitude);
+    q0 = q0*magnitude;
+    q1 = q1*magnitude;
+    q2 = q2*magnitude;
+    q3 = q3*magnitude;
+}
+
+// Same Entries as quaternion::RotationMatrix3/4, Transposed When is_transposed.
+// Matrix i Starts at matrices + i*stride, Streamed Matrices are 4x4 Only
+template<int N, bool is_transposed>
+void WriteMatrices(T * __restrict__ matrices, const size_t begin, const size_t end, const size_t stride,
+const bool is_streamed) const {
+    const T * __restrict__ q0 = quat[0].data();
+    const T * __restrict__ q1 = quat[1].data();
+    const T * __restrict__ q2 = quat[2].data();
+    const T * __restrict__ q3 = quat[3].data();
+
+    for(size_t i=begin; i<end; i++){
+        T streamed[16];
+        T *matrix = is_streamed ? streamed : matrices + i*stride;
+        T m[3][3];
+        m[0][0] = 2*(q0[i]*q0[i] + q1[i]*q1[i]) - 1;
+        m[0][1] = 2*(q1[i]*q2[i] - q0[i]*q3[i]);
+        m[0][2] = 2*(q1[i]*q3[i] + q0[i]*q2[i]);
+        m[1][0] = 2*(q1[i]*q2[i] + q0[i]*q3[i]);
+        m[1][1] = 2*(q0[i]*q0[i] + q2[i]*q2[i]) - 1;
+        m[1][2] = 2*(q2[i]*q3[i] - q0[i]*q1[i]);
+        m[2][0] = 2*(q1[i]*q3[i] - q0[i]*q2[i]);
+        m[2][1] = 2*(q2[i]*q3[i] + q0[i]*q1[i]);
+        m[2][2] = 2*(q0[i]*q0[i] + q3[i]*q3[i]) - 1;
+
+        for(int row=0; row<3; row++){
+            for(int col=0; col<3; col++){
+                matrix[row*N + col] = is_transposed ? m[col][row] : m[row][col];
+            }
+        }
+        if(N == 4){
+            matrix[3] = 0;
+            matrix[7] = 0;
+            matrix[11] = 0;
+            matrix[12] = 0;
+            matrix[13] = 0;
+            matrix[14] = 0;
+            matrix[15] = 1;
+        }
+        if(is_streamed){StoreMat4(streamed, matrices + i*stride, row_major, true);}
+    }
+}
+
+// WriteMatrices() Over Every Quaternion, Split Across pool
+template<int N, bool is_transposed>
+void WriteMatricesParallel(T *matrices, thread_pool &pool) const {
+    struct matrix_job{
+        const quaternion_array &quats;
+        T *matrices;
+        void operator()(const size_t begin, const size_t end){
+            quats.template WriteMatrices<N, is_transposed>(matrices, begin, end, N*N, false);
+        }
+    } job = {*this, matrices};
+    pool.ParallelFor(Size(), quat_chunk_size, job);
+}
+
+// Rotates Points begin to end by the Matching Quaternions
+void RotateRange(float * __restrict__ x, float * __restrict__ y, float * __restrict__ z,
+const size_t begin, const size_t end) const {
+    const T * __restrict__ q0 = quat[0].data();
+    const T * __restrict__ q1 = quat[1].data();
+    const T * __restrict__ q2 = quat[2].data();
+    const T * __restrict__ q3 = quat[3].data();
+
+    for(size_t i=begin; i<end; i++){
+        float q[3] = {(float)q1[i], (float)q2[i], (float)q3[i]};
+        float qcrossr[3] = {q[1]*z[i] - q[2]*y[i], q[2]*x[i] - q[0]*z[i], q[0]*y[i] - q[1]*x[i]};
+
+        for(int k=0; k<3; k++){
+            q[k] = 2*q[k];
+        }
+        float qright[3] = {q[1]*qcrossr[2] - q[2]*qcrossr[1], q[2]*qcrossr[0] - q[0]*qcrossr[2],
+            q[0]*qcrossr[1] - q[1]*qcrossr[0]};
+
+        x[i] += 2*q0[i]*qcrossr[0] + qright[0];
+        y[i] += 2*q0[i]*qcrossr[1] + qright[1];
+        z[i] += 2*q0[i]*qcrossr[2] + qright[2];
+    }
+}
+
+std::vector<T> quat[4];
+
+};
+
+
+
+// Points per Parallel Chunk, About 48 KB of Interleaved Points
+const size_t point_chunk_size = 4096;
+
+// Points Deinterleaved at a Time so the Rotation Runs on Contiguous Arrays
+const size_t point_block_size = 256;
+
+
+// Rotates count Points Stored in x[i], y[i], z[i] by quat, Using the Same
+// Operations as quaternion::Rotate
+template<typename T>
+void RotatePointsSerial(const quaternion<T> &quat, float * __restrict__ x, float * __restrict__ y,
+float * __restrict__ z, const size_t count){
+    const T *data = quat.RawData();
+    float q[3] = {(float)data[1], (float)data[2], (float)data[3]};
+    float q2[3] = {2*q[0], 2*q[1], 2*q[2]};
+    float w2 = (float)(2*data[0]);
+
+    for(size_t i=0; i<count; i++){
+        float qcrossr[3] = {q[1]*z[i] - q[2]*y[i], q[2]*x[i] - q[0]*z[i], q[0]*y[i] - q[1]*x[i]};
+        float qright[3] = {q2[1]*qcrossr[2] - q2[2]*qcrossr[1], q2[2]*qcrossr[0] - q2[0]*qcrossr[2],
+            q2[0]*qcrossr[1] - q2[1]*qcrossr[0]};
+
+        x[i] += w2*qcrossr[0] + qright[0];
+        y[i] += w2*qcrossr[1] + qright[1];
+        z[i] += w2*qcrossr[2] + qright[2];
+    }
+}
+
+
+// Rotates count Points x[i], y[i], z[i] by quat Into out_x, out_y, out_z,
+// Using the Same Operations as quaternion::Rotate. Outputs Must Not
+// Overlap the Inputs, Use the in Place Overload for That
+template<typename T>
+void RotatePointsSerial(const quaternion<T> &quat, const float * __restrict__ x, const float * __restrict__ y,
+const float * __restrict__ z, float * __restrict__ out_x, float * __restrict__ out_y,
+float * __restrict__ out_z, const size_t count){
+    const T *data = quat.RawData();
+    float q[3] = {(float)data[1], (float)data[2], (float)data[3]};
+    float q2[3] = {2*q[0], 2*q[1], 2*q[2]};
+    float w2 = (float)(2*data[0]);
+
+    for(size_t i=0; i<count; i++){
+        float qcrossr[3] = {q[1]*z[i] - q[2]*y[i], q[2]*x[i] - q[0]*z[i], q[0]*y[i] - q[1]*x[i]};
+        float qright[3] = {q2[1]*qcrossr[2] - q2[2]*qcrossr[1], q2[2]*qcrossr[0] - q2[0]*qcrossr[2],
+            q2[0]*qcrossr[1] - q2[1]*qcrossr[0]};
+
+        out_x[i] = x[i] + (w2*qcrossr[0] + qright[0]);
+        out_y[i] = y[i] + (w2*qcrossr[1] + qright[1]);
+        out_z[i] = z[i] + (w2*qcrossr[2] + qright[2]);
+    }
+}
+
+
+// Rotates count Interleaved xyz Points From points_in Into points_out.
+// points_out may Equal points_in to Rotate in Place
+template<typename T>
+void RotatePointsSerial(const quaternion<T> &quat, const float *points_in, float *points_out,
+const size_t count){
+    float x[point_block_size];
+    float y[point_block_size];
+    float z[point_block_size];
+
+    for(size_t begin=0; begin<count; begin+=point_block_size){
+        size_t size = std::min(point_block_size, count - begin);
+        const float *in = points_in + 3*begin;
+        float *out = points_out + 3*begin;
+
+        for(size_t i=0; i<size; i++){
+            x[i] = in[3*i];
+            y[i] = in[3*i + 1];
+            z[i] = in[3*i + 2];
+        }
+        RotatePointsSerial(quat, x, y, z, size);
+        for(size_t i=0; i<size; i++){
+            out[3*i] = x[i];
+            out[3*i + 1] = y[i];
+            out[3*i + 2] = z[i];
+        }
+    }
+}
+
+
+// Rotates count Interleaved xyz Points in Parallel. points_out may
+// Equal points_in to Rotate in Place Without a Second Buffer
+template<typename T>
+void RotatePoints(const quaternion<T> &quat, const float *points_in, float *points_out,
+const size_t count, thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE("RotatePoints");
+    struct rotate_job{
+        const quaternion<T> &quat;
+        const float *points_in;
+        float *points_out;
+        void operator()(const size_t begin, const size_t end){
+            RotatePointsSerial(quat, points_in + 3*begin, points_out + 3*begin, end - begin);
+        }
+    } job = {quat, points_in, points_out};
+    pool.ParallelFor(count, point_chunk_size, job);
+}
+
+
+// Rotates count Points Stored in x[i], y[i], z[i] in Place, in Parallel
+template<typename T>
+void RotatePoints(const quaternion<T> &quat, float *x, float *y, float *z,
+const size_t count, thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE("RotatePoints");
+    struct rotate_job{
+        const quaternion<T> &quat;
+        float *x;
+        float *y;
+        float *z;
+        void operator()(const size_t begin, const size_t end){
+            RotatePointsSerial(quat, x + begin, y + begin, z + begin, end - begin);
+        }
+    } job = {quat, x, y, z};
+    pool.ParallelFor(count, point_chunk_size, job);
+}
+
+
+// Rotates count Points x[i], y[i], z[i] Into out_x, out_y, out_z in
+// Parallel, Leaving the Inputs as They Were. Outputs Must Not Overlap the
+// Inputs
+template<typename T>
+void RotatePoints(const quaternion<T> &quat, const float *x, const float *y, const float *z,
+float *out_x, float *out_y, float *out_z, const size_t count, thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE("RotatePoints");
+    struct rotate_job{
+        const quaternion<T> &quat;
+        const float *x;
+        const float *y;
+        const float *z;
+        float *out_x;
+        float *out_y;
+        float *out_z;
+        void operator()(const size_t begin, const size_t end){
+            RotatePointsSerial(quat, x + begin, y + begin, z + begin, out_x + begin, out_y + begin, out_z + begin,
+                end - begin);
+        }
+    } job = {quat, x, y, z, out_x, out_y, out_z};
+    pool.ParallelFor(count, point_chunk_size, job);
+}
+
+
+
+// Maps count Normalized Device Coordinates x[i], y[i], z[i] (Depth in
+// [-1, 1]) Through inverse_view_proj, e.g. From InverseViewProjMatrix(),
+// and Writes the World Space Points to out_x, out_y, out_z. Outputs Must
+// Not Overlap the Inputs
+void UnprojectPointsSerial(const float * __restrict__ inverse_view_proj, const float * __restrict__ x,
+const float * __restrict__ y, const float * __restrict__ z, float * __restrict__ out_x,
+float * __restrict__ out_y, float * __restrict__ out_z, const size_t count){
+    float m[16];
+    std::copy(inverse_view_proj, inverse_view_proj + 16, m);
+
+    for(size_t i=0; i<count; i++){
+        float inverse_w = 1/(m[12]*x[i] + m[13]*y[i] + m[14]*z[i] + m[15]);
+        out_x[i] = (m[0]*x[i] + m[1]*y[i] + m[2]*z[i] + m[3])*inverse_w;
+        out_y[i] = (m[4]*x[i] + m[5]*y[i] + m[6]*z[i] + m[7])*inverse_w;
+        out_z[i] = (m[8]*x[i] + m[9]*y[i] + m[10]*z[i] + m[11])*inverse_w;
+    }
+}
+
+
+// Same as UnprojectPointsSerial() Split Across pool
+void UnprojectPoints(const float *inverse_view_proj, const float *x, const float *y, const float *z,
+float *out_x, float *out_y, float *out_z, const size_t count, thread_pool &pool = DefaultThreadPool()){
+    AGP_TRACE_SCOPE("UnprojectPoints");
+    struct unproject_job{
+        const float *inverse_view_proj;
+        const float *x;
+        const float *y;
+        const float *z;
+        float *out_x;
+        float *out_y;
+        float *out_z;
+        void operator()(const size_t begin, const size_t end){
+            UnprojectPointsSerial(inverse_view_proj, x + begin, y + begin, z + begin,
+                out_x + begin, out_y + begin, out_z + begin, end - begin);
+        }
+    } job = {inverse_view_proj, x, y, z, out_x, out_y, out_z};
+    pool.ParallelFor(count, point_chunk_size, job);
+}
+
+
+
+enum arcball_event_type { event_rotate, event_translate, event_zoom };
+
+
+struct arcball_event{
+    arcball_event_type type;
+    float x;
+    float y;
+    float zoom;
+};
+
+
+// Lock-Free Single Producer, Single Consumer Queue of Mouse Input for an
+// arcball. The Input Thread Pushes Events, the Render Thread Drains Them
+// Once per Frame. Runs of the Same Event Type are Coalesced Into as Few
+// arcball Calls as Possible While Matching Their Sequential Result
+class arcball_event_queue{
+
+public:
+
+// Constructors
+// capacity is Rounded Up to a Power of Two
+explicit arcball_event_queue(const size_t capacity = 1024){
+    size_t size = 1;
+    while(size < capacity){size *= 2;}
+    events.resize(size);
+    mask = size - 1;
+};
+
+
+// Member Functions
+
+// Producer Side. Returns false, Dropping the Event, When the Queue is Full
+bool PushRotate(const float delta_x, const float delta_y){
+    arcball_event event = {event_rotate, delta_x, delta_y, 0};
+    return Push(event);
+}
+
+bool PushTranslate(const float delta_x, const float delta_y){
+    arcball_event event = {event_translate, delta_x, delta_y, 0};
+    return Push(event);
+}
+
+bool PushZoom(const float mouse_x, const float mouse_y, const float zoom){
+    arcball_event event = {event_zoom, mouse_x, mouse_y, zoom};
+    return Push(event);
+}
+
+// Consumer Side. Applies Every Queued Event to arc and Returns How Many
+size_t Drain(arcball &arc){
+    size_t begin = head.load(std::memory_order_relaxed);
+    size_t end = tail.load(std::memory_order_acquire);
+
+    size_t i = begin;
+    while(i < end){
+        const arcball_event &first = events[i & mask];
+        size_t run_end = i + 1;
+        while(run_end < end && IsSameRun(first, events[run_end & mask])){run_end++;}
+
+        switch(first.type){
+            case event_rotate: ApplyRotate(arc, i, run_end); break;
+            case event_translate: ApplyTranslate(arc, i, run_end); break;
+            case event_zoom: ApplyZoom(arc, i, run_end); break;
+        }
+        i = run_end;
+    }
+
+    head.store(end, std::memory_order_release);
+    return end - begin;
+}
+
+
+private:
+
+bool Push(const arcball_event &event){
+    size_t index = tail.load(std::memory_order_relaxed);
+    if(index - head.load(std::memory_order_acquire) > mask){return false;}
+    events[index & mask] = event;
+    tail.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+// Zooms Only Coalesce at the Same Mouse Position
+static bool IsSameRun(const arcball_event &first, const arcball_event &event){
+    if(first.type != event.type){return false;}
+    if(first.type != event_zoom){return true;}
+    return first.x == event.x && first.y == event.y;
+}
+
+// Each Rotate is a Rotation by rotate_sensitivity*|delta| About the Local
+// Axis (-delta_y, -delta_x, 0)/|delta|, so a Run Composes Into One Quaternion.
+// Matches Sequential Rotates Up to Their O(theta^2) Up Vector Drift
+void ApplyRotate(arcball &arc, const size_t begin, const size_t end){
+    if(end - begin == 1){
+        arc.Rotate(events[begin & mask].x, events[begin & mask].y);
+        return;
+    }
+
+    quaternion<float> total;
+    bool is_rotated = false;
+    for(size_t i=begin; i<end; i++){
+        const arcball_event &event = events[i & mask];
+        if(event.x == 0 && event.y == 0){continue;}
+
+        float magnitude = sqrt(event.x*event.x + event.y*event.y);
+        float half_theta = 0.5*arc.rotate_sensitivity*magnitude;
+        float sine = sin(half_theta)/magnitude;
+        quaternion<float> step = {(float)cos(half_theta), -event.y*sine, -event.x*sine, 0};
+        total = total * step;
+        is_rotated = true;
+    }
+    if(!is_rotated){return;}
+
+    float rotation[9];
+    total.RotationMatrix3(rotation);
+    arc.RotateLocal(rotation);
+}
+
+// Translate Doesn't Change the Basis or Radius, so Deltas Simply Add
+void ApplyTranslate(arcball &arc, const size_t begin, const size_t end){
+    float delta_x = 0;
+    float delta_y = 0;
+    for(size_t i=begin; i<end; i++){
+        delta_x += events[i & mask].x;
+        delta_y += events[i & mask].y;
+    }
+    arc.Translate(delta_x, delta_y);
+}
+
+// Replays the Radius Sequence of the Run. Each Negative Zoom Translates
+// Toward the Mouse in Proportion to the Radius at That Step, Which Sums
+// Into a Single Translate Before One Radius Change
+void ApplyZoom(arcball &arc, const size_t begin, const size_t end){
+    const float mouse_x = events[begin & mask].x;
+    const float mouse_y = events[begin & mask].y;
+    const float start_radius = arc.Radius();
+
+    if(end - begin == 1 || start_radius <= 0 || arc.zoom_sensitivity == 0){
+        for(size_t i=begin; i<end; i++){
+            arc.Zoom(mouse_x, mouse_y, events[i & mask].zoom);
+        }
+        return;
+    }
+
+    float radius = start_radius;
+    float radius_sum = 0;
+    for(size_t i=begin; i<end; i++){
+        float zoom = events[i & mask].zoom;
+        if(zoom < 0){radius_sum += radius;}
+        radius += arc.zoom_sensitivity*zoom;
+        if(radius < 0){radius = .001;}
+    }
+
+    float scale = arc.zoom_translate_sensitivity*radius_sum/start_radius;
+    arc.Translate(scale*mouse_x, scale*mouse_y);
+    arc.Zoom(0, 0, (radius - start_radius)/arc.zoom_sensitivity);
+}
+
+std::vector<arcball_event> events;
+
+size_t mask;
+
+// Consumer and Producer Indices on Separate Cache Lines
+alignas(64) std::atomic<size_t> head{0};
+
+alignas(64) std::atomic<size_t> tail{0};
+
+};
+
+
+
+// Immutable Copy of an arcball's Camera State for One Frame
+struct arcball_snapshot{
+    float camera_pos[3];
+    float center_pos[3];
+    float basis[9];
+    float view_proj[16];
+    unsigned version;
+};
+
+
+// Publishes arcball Snapshots From One Writer Thread to Any Number of
+// Reader Threads Through a Seqlock. Readers Never Block the Writer and
+// Retry Instead of Returning a Half Written Snapshot
+class arcball_publisher{
+
+public:
+
+// Constructors
+arcball_publisher(){
+    for(int i=0; i<word_count; i++){
+        data[i].store(0, std::memory_order_relaxed);
+    }
+};
+
+
+// Member Functions
+
+// Writer Side. Does Nothing if arc Hasn't Changed Since the Last Publish
+void Publish(arcball &arc){
+    unsigned version = arc.Version();
+    if(is_published && version == published_version){return;}
+
+    float words[word_count];
+    std::copy(arc.Camera(), arc.Camera() + 3, words);
+    std::copy(arc.Center(), arc.Center() + 3, words + 3);
+    std::copy(arc.Basis(), arc.Basis() + 9, words + 6);
+    arc.ViewProjMatrix(words + 15);
+
+    // Odd Sequence Marks a Write in Progress
+    unsigned sequence = sequence_count.load(std::memory_order_relaxed);
+    sequence_count.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for(int i=0; i<word_count; i++){
+        data[i].store(words[i], std::memory_order_relaxed);
+    }
+    snapshot_version.store(version, std::memory_order_relaxed);
+
+    sequence_count.store(sequence + 2, std::memory_order_release);
+    published_version = version;
+    is_published = true;
+}
+
+// Reader Side. Returns false if Nothing Has Been Published Yet
+bool Read(arcball_snapshot &snapshot) const {
+    float words[word_count];
+    unsigned version;
+    unsigned sequence;
+    for(;;){
+        sequence = sequence_count.load(std::memory_order_acquire);
+        if(sequence & 1){
+            std::this_thread::yield();
+            continue;
+        }
+
+        for(int i=0; i<word_count; i++){
+            words[i] = data[i].load(std::memory_order_relaxed);
+        }
+        version = snapshot_version.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(sequence_count.load(std::memory_order_relaxed) == sequence){break;}
+    }
+    if(sequence == 0){return false;}
+
+    std::copy(words, words + 3, snapshot.camera_pos);
+    std::copy(words + 3, words + 6, snapshot.center_pos);
+    std::copy(words + 6, words + 15, snapshot.basis);
+    std::copy(words + 15, words + 31, snapshot.view_proj);
+    snapshot.version = version;
+    return true;
+}
+
+// Number of Snapshots Published So Far
+unsigned Count() const {
+    return sequence_count.load(std::memory_order_acquire)/2;
+}
+
+
+private:
+
+static const int word_count = 31;
+
+std::atomic<unsigned> sequence_count{0};
+
+std::atomic<unsigned> snapshot_version{0};
+
+std::atomic<float> data[word_count];
+
+// Only Touched by the Writer
+unsigned published_version = 0;
+
+bool is_published = false;
+
+};
+
+
+
+// Node of a bvh. Leaves Have count > 0 and Hold Primitives [first, first + count)
+// of the Index List, Interior Nodes Have count == 0 and Children first, first + 1
+struct bvh_node{
+    float min[3];
+    float max[3];
+    uint32_t first;
+    uint32_t count;
+};
+
+
+// Closest Hit Found by bvh::Intersect(). distance is Along the Ray Direction
+// in Multiples of its Length. u, v are Barycentric Coordinates for Triangles
+struct bvh_hit{
+    size_t primitive;
+    float distance;
+    float u;
+    float v;
+};
+
+
+const size_t bvh_bin_count = 16;
+
+const size_t bvh_leaf_size = 4;
+
+// Primitives per Thread Pool Chunk When Binning a Node
+const size_t bvh_chunk_size = 16384;
+
+// Below This Depth Nodes Split at the Median, Which Bounds the Tree Depth
+const size_t bvh_max_sah_depth = 32;
+
+
+// Bounding Volume Hierarchy for Picking. Built With Binned SAH, Large Nodes
+// are Binned Across a thread_pool. Primitives are Read From the Caller's
+// Array, Which Must Outlive the bvh. After Moving Primitives in That Array,
+// Refit() Updates the Bounds Without Rebuilding
+class bvh{
+
+public:
+
+// Member Functions
+
+// triangles Holds 9 Floats per Triangle: 3 Vertices of x, y, z
+void BuildTriangles(const float *triangles, const size_t count, thread_pool &pool = DefaultThreadPool()){
+    primitives = triangles;
+    is_triangles = true;
+    Build(count, pool);
+}
+
+// boxes Holds 6 Floats per Box: min x, y, z Then max x, y, z
+void BuildBoxes(const float *boxes, const size_t count, thread_pool &pool = DefaultThreadPool()){
+    primitives = boxes;
+    is_triangles = false;
+    Build(count, pool);
+}
+
+size_t Size() const {return leaf_of.size();}
+
+size_t NodeCount() const {return nodes.size();}
+
+const bvh_node *Nodes() const {return nodes.data();}
+
+// Recomputes Every Node's Bounds From the Primitive Array
+void Refit(){
+    for(size_t i=nodes.size(); i-- > 0;){
+        FitNode(i);
+    }
+}
+
+// Recomputes Bounds Only Along the Paths From changed Primitives to the Root
+void Refit(const size_t *changed, const size_t changed_count){
+    for(size_t i=0; i<changed_count; i++){
+        if(changed[i] >= leaf_of.size()){AGP_THROW("Primitive Out of Bounds");}
+
+        uint32_t node = leaf_of[changed[i]];
+        FitNode(node);
+        while(node != 0){
+            node = parents[node];
+            if(!FitNode(node)){break;}
+        }
+    }
+}
+
+// Finds the Closest Primitive Hit by origin + t*direction, t > 0
+bool Intersect(const float *origin, const float *direction, bvh_hit &hit) const {
+    if(nodes.empty()){return false;}
+
+    float inverse[3];
+    for(int i=0; i<3; i++){
+        inverse[i] = 1/direction[i];
+    }
+
+    float closest = std::numeric_limits<float>::infinity();
+    bool is_hit = false;
+    float entry;
+    if(!BoxEntry(nodes[0].min, nodes[0].max, origin, inverse, closest, entry)){return false;}
+
+    // Depth is Bounded by bvh_max_sah_depth Plus the Median Split Levels
+    uint32_t stack[64 + bvh_max_sah_depth];
+    size_t stack_size = 0;
+    uint32_t index = 0;
+    for(;;){
+        const bvh_node &node = nodes[index];
+        if(node.count > 0){
+            for(uint32_t i=node.first; i<node.first + node.count; i++){
+                if(IntersectPrimitive(indices[i], origin, direction, inverse, closest, hit)){
+                    is_hit = true;
+                }
+            }
+        }
+        else{
+            // Visit the Nearer Child First
+            float near_entry;
+            float far_entry;
+            uint32_t near_child = node.first;
+            uint32_t far_child = node.first + 1;
+            bool is_near = BoxEntry(nodes[near_child].min, nodes[near_child].max, origin, inverse, closest, near_entry);
+            bool is_far = BoxEntry(nodes[far_child].min, nodes[far_child].max, origin, inverse, closest, far_entry);
+            if(is_near && is_far){
+                if(far_entry < near_entry){std::swap(near_child, far_child);}
+                stack[stack_size++] = far_child;
+                index = near_child;
+                continue;
+            }
+            if(is_near){index = near_child; continue;}
+            if(is_far){index = far_child; continue;}
+        }
+
+        // Pop, Skipping Nodes Farther Than the Closest Hit
+        bool is_found = false;
+        while(stack_size > 0){
+            index = stack[--stack_size];
+            if(BoxEntry(nodes[index].min, nodes[index].max, origin, inverse, closest, entry)){
+                is_found = true;
+                break;
+            }
+        }
+        if(!is_found){break;}
+    }
+    return is_hit;
+}
+
+// Closest Primitive Under the Mouse, Using the Same Mouse Coordinates as MouseRay()
+bool Pick(arcball &arc, const float mouse_x, const float mouse_y, bvh_hit &hit) const {
+    float direction[3];
+    arc.MouseRay(mouse_x, mouse_y, direction);
+    return Intersect(arc.Camera(), direction, hit);
+}
+
+
+private:
+
+struct bounds{
+    float min[3];
+    float max[3];
+
+    void Reset(){
+        for(int i=0; i<3; i++){
+            min[i] = std::numeric_limits<float>::infinity();
+            max[i] = -std::numeric_limits<float>::infinity();
+        }
+    }
+
+    void Grow(const float *grow_min, const float *grow_max){
+        for(int i=0; i<3; i++){
+            min[i] = std::min(min[i], grow_min[i]);
+            max[i] = std::max(max[i], grow_max[i]);
+        }
+    }
+
+    float HalfArea() const {
+        if(min[0] > max[0]){return 0;}
+        float x = max[0] - min[0];
+        float y = max[1] - min[1];
+        float z = max[2] - min[2];
+        return x*y + y*z + z*x;
+    }
+};
+
+struct bin_set{
+    bounds bin_bounds[3][bvh_bin_count];
+    uint32_t bin_counts[3][bvh_bin_count];
+
+    void Reset(){
+        for(int axis=0; axis<3; axis++){
+            for(size_t i=0; i<bvh_bin_count; i++){
+                bin_bounds[axis][i].Reset();
+                bin_counts[axis][i] = 0;
+            }
+        }
+    }
+};
+
+void PrimitiveBounds(const size_t primitive, float *min, float *max) const {
+    if(is_triangles){
+        const float *vertices = primitives + 9*primitive;
+        for(int i=0; i<3; i++){
+            min[i] = std::min(vertices[i], std::min(vertices[i + 3], vertices[i + 6]));
+            max[i] = std::max(vertices[i], std::max(vertices[i + 3], vertices[i + 6]));
+        }
+    }
+    else{
+        std::copy(primitives + 6*primitive, primitives + 6*primitive + 3, min);
+        std::copy(primitives + 6*primitive + 3, primitives + 6*primitive + 6, max);
+    }
+}
+
+void Build(const size_t count, thread_pool &pool){
+    if(count >= std::numeric_limits<uint32_t>::max()){AGP_THROW("Too Many Primitives");}
+
+    nodes.clear();
+    parents.clear();
+    leaf_of.assign(count, 0);
+    if(count == 0){return;}
+
+    indices.resize(count);
+    centroids.resize(3*count);
+    for(size_t i=0; i<count; i++){
+        indices[i] = i;
+        float min[3];
+        float max[3];
+        PrimitiveBounds(i, min, max);
+        for(int j=0; j<3; j++){
+            centroids[3*i + j] = 0.5f*(min[j] + max[j]);
+        }
+    }
+
+    nodes.reserve(2*count/bvh_leaf_size + 1);
+    parents.reserve(2*count/bvh_leaf_size + 1);
+    bvh_node root = {{0, 0, 0}, {0, 0, 0}, 0, (uint32_t)count};
+    nodes.push_back(root);
+    parents.push_back(0);
+
+    // Nodes Waiting to be Split, With Their Depth
+    std::vector<std::pair<uint32_t, size_t> > stack(1, std::make_pair(0u, (size_t)0));
+    while(!stack.empty()){
+        uint32_t index = stack.back().first;
+        size_t depth = stack.back().second;
+        stack.pop_back();
+
+        if(Split(index, depth, pool)){
+            uint32_t child = nodes[index].first;
+            stack.push_back(std::make_pair(child, depth + 1));
+            stack.push_back(std::make_pair(child + 1, depth + 1));
+        }
+    }
+
+    for(size_t i=0; i<nodes.size(); i++){
+        for(uint32_t j=nodes[i].first; nodes[i].count > 0 && j<nodes[i].first + nodes[i].count; j++){
+            leaf_of[indices[j]] = i;
+        }
+    }
+    std::vector<float>().swap(centroids);
+}
+
+// Sets the Node's Bounds and Either Splits it, Returning true, or Leaves it a Leaf
+bool Split(const uint32_t index, const size_t depth, thread_pool &pool){
+    const uint32_t first = nodes[index].first;
+    const uint32_t count = nodes[index].count;
+
+    // Node and Centroid Bounds
+    struct measure_job{
+        const bvh *tree;
+        uint32_t first;
+        bounds node_bounds;
+        bounds centroid_bounds;
+        std::mutex lock;
+        void operator()(const size_t begin, const size_t end){
+            bounds local_node;
+            bounds local_centroid;
+            local_node.Reset();
+            local_centroid.Reset();
+            for(size_t i=first + begin; i<first + end; i++){
+                float min[3];
+                float max[3];
+                tree->PrimitiveBounds(tree->indices[i], min, max);
+                local_node.Grow(min, max);
+                const float *centroid = &tree->centroids[3*tree->indices[i]];
+                local_centroid.Grow(centroid, centroid);
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            node_bounds.Grow(local_node.min, local_node.max);
+            centroid_bounds.Grow(local_centroid.min, local_centroid.max);
+        }
+    } measure;
+    measure.tree = this;
+    measure.first = first;
+    measure.node_bounds.Reset();
+    measure.centroid_bounds.Reset();
+    pool.ParallelFor(count, bvh_chunk_size, measure);
+
+    bvh_node &node = nodes[index];
+    std::copy(measure.node_bounds.min, measure.node_bounds.min + 3, node.min);
+    std::copy(measure.node_bounds.max, measure.node_bounds.max + 3, node.max);
+    if(count <= bvh_leaf_size){return false;}
+
+    const bounds &centroid_bounds = measure.centroid_bounds;
+    float scale[3];
+    for(int axis=0; axis<3; axis++){
+        float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+        scale[axis] = extent > 0 ? bvh_bin_count/extent : 0;
+    }
+
+    int best_axis = -1;
+    size_t best_split = 0;
+    uint32_t middle = first + count/2;
+    if(depth < bvh_max_sah_depth){
+        // Bin Centroids Along All Three Axes
+        struct bin_job{
+            const bvh *tree;
+            uint32_t first;
+            const float *origin;
+            const float *scale;
+            bin_set bins;
+            std::mutex lock;
+            void operator()(const size_t begin, const size_t end){
+                bin_set local;
+                local.Reset();
+                for(size_t i=first + begin; i<first + end; i++){
+                    float min[3];
+                    float max[3];
+                    tree->PrimitiveBounds(tree->indices[i], min, max);
+                    const float *centroid = &tree->centroids[3*tree->indices[i]];
+                    for(int axis=0; axis<3; axis++){
+                        size_t bin = BinIndex(centroid[axis], origin[axis], scale[axis]);
+                        local.bin_bounds[axis][bin].Grow(min, max);
+                        local.bin_counts[axis][bin]++;
+                    }
+                }
+                std::lock_guard<std::mutex> guard(lock);
+                for(int axis=0; axis<3; axis++){
+                    for(size_t bin=0; bin<bvh_bin_count; bin++){
+                        bins.bin_bounds[axis][bin].Grow(local.bin_bounds[axis][bin].min, local.bin_bounds[axis][bin].max);
+                        bins.bin_counts[axis][bin] += local.bin_counts[axis][bin];
+                    }
+                }
+            }
+        } binning;
+        binning.tree = this;
+        binning.first = first;
+        binning.origin = centroid_bounds.min;
+        binning.scale = scale;
+        binning.bins.Reset();
+        pool.ParallelFor(count, bvh_chunk_size, binning);
+
+        // Sweep Each Axis for the Split With the Lowest Surface Area Cost
+        float best_cost = count*measure.node_bounds.HalfArea();
+        for(int axis=0; axis<3; axis++){
+            if(scale[axis] == 0){continue;}
+
+            float left_area[bvh_bin_count];
+            uint32_t left_count[bvh_bin_count];
+            bounds left;
+            left.Reset();
+            uint32_t running = 0;
+            for(size_t bin=0; bin<bvh_bin_count; bin++){
+                left.Grow(binning.bins.bin_bounds[axis][bin].min, binning.bins.bin_bounds[axis][bin].max);
+                running += binning.bins.bin_counts[axis][bin];
+                left_area[bin] = left.HalfArea();
+                left_count[bin] = running;
+            }
+
+            bounds right;
+            right.Reset();
+            for(size_t bin=bvh_bin_count - 1; bin>0; bin--){
+                right.Grow(binning.bins.bin_bounds[axis][bin].min, binning.bins.bin_bounds[axis][bin].max);
+                uint32_t lower = left_count[bin - 1];
+                if(lower == 0 || lower == count){continue;}
+
+                float cost = lower*left_area[bin - 1] + (count - lower)*right.HalfArea();
+                if(cost < best_cost){
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = bin;
+                }
+            }
+        }
+
+        // Not Worth Splitting
+        if(best_axis < 0 && count <= 4*bvh_leaf_size){return false;}
+    }
+
+    if(best_axis >= 0){
+        const float origin = centroid_bounds.min[best_axis];
+        const float axis_scale = scale[best_axis];
+        const float *centroid_data = centroids.data();
+        const int axis = best_axis;
+        const size_t split = best_split;
+        middle = std::partition(indices.begin() + first, indices.begin() + first + count, [=](const uint32_t primitive){
+            return BinIndex(centroid_data[3*primitive + axis], origin, axis_scale) < split;
+        }) - indices.begin();
+    }
+    else{
+        // Median Split Along the Widest Centroid Axis
+        int axis = 0;
+        for(int i=1; i<3; i++){
+            if(centroid_bounds.max[i] - centroid_bounds.min[i] > centroid_bounds.max[axis] - centroid_bounds.min[axis]){axis = i;}
+        }
+        const float *centroid_data = centroids.data();
+        std::nth_element(indices.begin() + first, indices.begin() + middle, indices.begin() + first + count,
+            [=](const uint32_t a, const uint32_t b){
+                return centroid_data[3*a + axis] < centroid_data[3*b + axis];
+            });
+    }
+
+    uint32_t child = nodes.size();
+    bvh_node left = {{0, 0, 0}, {0, 0, 0}, first, middle - first};
+    bvh_node right = {{0, 0, 0}, {0, 0, 0}, middle, first + count - middle};
+    nodes[index].first = child;
+    nodes[index].count = 0;
+    nodes.push_back(left);
+    nodes.push_back(right);
+    parents.push_back(index);
+    parents.push_back(index);
+    return true;
+}
+
+static size_t BinIndex(const float centroid, const float origin, const float scale){
+    size_t bin = (size_t)std::max(0.0f, (centroid - origin)*scale);
+    return std::min(bin, bvh_bin_count - 1);
+}
+
+// Recomputes One Node's Bounds, Returns true if They Changed
+bool FitNode(const size_t index){
+    bvh_node &node = nodes[index];
+    bounds fit;
+    fit.Reset();
+    if(node.count > 0){
+        for(uint32_t i=node.first; i<node.first + node.count; i++){
+            float min[3];
+            float max[3];
+            PrimitiveBounds(indices[i], min, max);
+            fit.Grow(min, max);
+        }
+    }
+    else{
+        fit.Grow(nodes[node.first].min, nodes[node.first].max);
+        fit.Grow(nodes[node.first + 1].min, nodes[node.first + 1].max);
+    }
+
+    bool is_changed = false;
+    for(int i=0; i<3; i++){
+        is_changed = is_changed || fit.min[i] != node.min[i] || fit.max[i] != node.max[i];
+    }
+    std::copy(fit.min, fit.min + 3, node.min);
+    std::copy(fit.max, fit.max + 3, node.max);
+    return is_changed;
+}
+
+// Slab Test. entry is Where the Ray Enters the Box, Clamped to 0
+static bool BoxEntry(const float *min, const float *max, const float *origin, const float *inverse,
+const float closest, float &entry){
+    float near = 0;
+    float far = closest;
+    for(int i=0; i<3; i++){
+        float t1 = (min[i] - origin[i])*inverse[i];
+        float t2 = (max[i] - origin[i])*inverse[i];
+        near = std::max(near, std::min(t1, t2));
+        far = std::min(far, std::max(t1, t2));
+    }
+    entry = near;
+    return near <= far;
+}
+
+// Moller-Trumbore for Triangles, Slab Test for Boxes
+bool IntersectPrimitive(const uint32_t primitive, const float *origin, const float *direction,
+const float *inverse, float &closest, bvh_hit &hit) const {
+    if(!is_triangles){
+        const float *box = primitives + 6*primitive;
+        float entry;
+        if(!BoxEntry(box, box + 3, origin, inverse, closest, entry) || !(entry < closest)){return false;}
+        closest = entry;
+        hit.primitive = primitive;
+        hit.distance = entry;
+        hit.u = 0;
+        hit.v = 0;
+        return true;
+    }
+
+    const float *vertices = primitives + 9*primitive;
+    float edge1[3];
+    float edge2[3];
+    float offset[3];
+    DiffVec<3>(vertices + 3, vertices, edge1);
+    DiffVec<3>(vertices + 6, vertices, edge2);
+    DiffVec<3>(origin, vertices, offset);
+
+    float p[3];
+    CrossVec(direction, edge2, p);
+    float determinant = DotVec<3>(edge1, p);
+    if(determinant == 0){return false;}
+    float inverse_determinant = 1/determinant;
+
+    float u = DotVec<3>(offset, p)*inverse_determinant;
+    if(u < 0 || u > 1){return false;}
+
+    float q[3];
+    CrossVec(offset, edge1, q);
+    float v = DotVec<3>(direction, q)*inverse_determinant;
+    if(v < 0 || u + v > 1){return false;}
+
+    float t = DotVec<3>(edge2, q)*inverse_determinant;
+    if(t <= 0 || t >= closest){return false;}
+
+    closest = t;
+    hit.primitive = primitive;
+    hit.distance = t;
+    hit.u = u;
+    hit.v = v;
+    return true;
+}
+
+std::vector<bvh_node> nodes;
+
+std::vector<uint32_t> parents;
+
+std::vector<uint32_t> indices;
+
+// Leaf Holding Each Primitive, for Incremental Refit
+std::vector<uint32_t> leaf_of;
+
+// Only Kept During Build
+std::vector<float> centroids;
+
+const float *primitives = 0;
+
+bool is_triangles = true;
+
+};
+
+
+
+// Objects Tested per Block, and per Thread Pool Chunk, When Culling
+const size_t cull_block_size = 256;
+
+const size_t cull_chunk_size = 65536;
+
+
+// Writes the Index of Each Box in [begin, end) That Touches the Frustum
+// planes From arcball::FrustumPlanes() to visible, Returns How Many. Boxes
+// are Separate Arrays of Their Min and Max Corners
+size_t CullBoxesSerial(const float *planes, const float *min_x, const float *min_y, const float *min_z,
+const float *max_x, const float *max_y, const float *max_z, const size_t begin, const size_t end, uint32_t *visible){
+    size_t visible_count = 0;
+    int inside[cull_block_size];
+    for(size_t block=begin; block<end; block+=cull_block_size){
+        const size_t count = std::min(cull_block_size, end - block);
+        std::fill(inside, inside + count, 1);
+
+        // Only the Corner Farthest Along Each Plane's Normal Needs Testing
+        for(int i=0; i<6; i++){
+            const float *plane = planes + 4*i;
+            const float a = plane[0];
+            const float b = plane[1];
+            const float c = plane[2];
+            const float d = plane[3];
+            const float * __restrict__ x = (a > 0 ? max_x : min_x) + block;
+            const float * __restrict__ y = (b > 0 ? max_y : min_y) + block;
+            const float * __restrict__ z = (c > 0 ? max_z : min_z) + block;
+            for(size_t j=0; j<count; j++){
+                inside[j] &= a*x[j] + b*y[j] + c*z[j] + d >= 0;
+            }
+        }
+
+        // Branchless Compaction
+        for(size_t j=0; j<count; j++){
+            visible[visible_count] = block + j;
+            visible_count += inside[j];
+        }
+    }
+    return visible_count;
+}
+
+// Same as CullBoxesSerial() for Spheres With Centers x, y, z
+size_t CullSpheresSerial(const float *planes, const float *x, const float *y, const float *z,
+const float *radius, const size_t begin, const size_t end, uint32_t *visible){
+    size_t visible_count = 0;
+    int inside[cull_block_size];
+    for(size_t block=begin; block<end; block+=cull_block_size){
+        const size_t count = std::min(cull_block_size, end - block);
+        std::fill(inside, inside + count, 1);
+
+        const float * __restrict__ block_x = x + block;
+        const float * __restrict__ block_y = y + block;
+        const float * __restrict__ block_z = z + block;
+        const float * __restrict__ block_radius = radius + block;
+        for(int i=0; i<6; i++){
+            const float *plane = planes + 4*i;
+            const float a = plane[0];
+            const float b = plane[1];
+            const float c = plane[2];
+            const float d = plane[3];
+            for(size_t j=0; j<count; j++){
+                inside[j] &= a*block_x[j] + b*block_y[j] + c*block_z[j] + d >= -block_radius[j];
+            }
+        }
+
+        for(size_t j=0; j<count; j++){
+            visible[visible_count] = block + j;
+            visible_count += inside[j];
+        }
+    }
+    return visible_count;
+}
+
+
+// Culls Chunks in Parallel, Each Into its Own Part of visible, Then Packs
+// the Parts Together so Indices Stay in Ascending Order
+template<typename F>
+size_t CullParallel(const size_t count, uint32_t *visible, thread_pool &pool, F &cull){
+    std::vector<size_t> chunk_counts((count + cull_chunk_size - 1)/cull_chunk_size);
+    struct cull_job{
+        F &cull;
+        uint32_t *visible;
+        size_t *chunk_counts;
+        void operator()(const size_t begin, const size_t end){
+            // Split Along Chunk Boundaries so Each Part Has a Fixed Home
+            for(size_t chunk_begin=begin; chunk_begin<end;){
+                size_t chunk = chunk_begin/cull_chunk_size;
+                size_t chunk_end = std::min(end, (chunk + 1)*cull_chunk_size);
+                chunk_counts[chunk] = cull(chunk_begin, chunk_end, visible + chunk_begin);
+                chunk_begin = chunk_end;
+            }
+        }
+    } job = {cull, visible, chunk_counts.data()};
+    pool.ParallelFor(count, cull_chunk_size, job);
+
+    size_t visible_count = chunk_counts.empty() ? 0 : chunk_counts[0];
+    for(size_t i=1; i<chunk_counts.size(); i++){
+        std::copy(visible + i*cull_chunk_size, visible + i*cull_chunk_size + chunk_counts[i], visible + visible_count);
+        visible_count += chunk_counts[i];
+    }
+    return visible_count;
+}
+
+
+// Writes the Ascending Indices of Boxes Touching the Frustum to visible,
+// Which Must Have Room for count Indices. Returns How Many are Visible
+size_t CullBoxes(const float *planes, const float *min_x, const float *min_y, const float *min_z,
+const float *max_x, const float *max_y, const float *max_z, const size_t count, uint32_t *visible,
+thread_pool &pool = DefaultThreadPool()){
+    struct box_cull{
+        const float *planes;
+        const float *min_x;
+        const float *min_y;
+        const float *min_z;
+        const float *max_x;
+        const float *max_y;
+        const float *max_z;
+        size_t operator()(const size_t begin, const size_t end, uint32_t *out){
+            return CullBoxesSerial(planes, min_x, min_y, min_z, max_x, max_y, max_z, begin, end, out);
+        }
+    } cull = {planes, min_x, min_y, min_z, max_x, max_y, max_z};
+    return CullParallel(count, visible, pool, cull);
+}
+
+// Same as CullBoxes() for Spheres With Centers x, y, z
+size_t CullSpheres(const float *planes, const float *x, const float *y, const float *z,
+const float *radius, const size_t count, uint32_t *visible, thread_pool &pool = DefaultThreadPool()){
+    struct sphere_cull{
+        const float *planes;
+        const float *x;
+        const float *y;
+        const float *z;
+        const float *radius;
+        size_t operator()(const size_t begin, const size_t end, uint32_t *out){
+            return CullSpheresSerial(planes, x, y, z, radius, begin, end, out);
+        }
+    } cull = {planes, x, y, z, radius};
+    return CullParallel(count, visible, pool, cull);
+}
+
+
+
+enum interpolation { interpolate_nlerp, interpolate_slerp, interpolate_squad };
+
+
+// Tracks Interpolated per Block When Sampling
+const size_t track_block_size = 64;
+
+
+// Keyframed Rotation Tracks. Each Track's Key Times and Quaternions are
+// Stored Contiguously With the Other Tracks', and a Cursor per Track Keeps
+// the Last Segment so Monotonic Playback Never Searches. Keys are Sign
+// Flipped When Added so Neighbours are Within 90 Degrees in Quaternion
+// Space, so Antipodal Keys Take the Short Path Instead of Throwing
+template <typename T> class quaternion_tracks{
+
+public:
+
+// Member Functions
+
+// Returns the New Track's Index. times Must be Increasing
+size_t Add(const float *times, const quaternion<T> *keys, const size_t key_count){
+    if(key_count == 0){AGP_THROW("Track Needs at Least One Key");}
+    for(size_t i=1; i<key_count; i++){
+        if(!(times[i] > times[i - 1])){AGP_THROW("Key Times Must Increase");}
+    }
+
+    const size_t first = key_times.size();
+    offsets.push_back(first);
+    counts.push_back(key_count);
+    cursors.push_back(0);
+
+    for(size_t i=0; i<key_count; i++){
+        const T *data = keys[i].RawData();
+        T dot = 0;
+        for(int j=0; j<4 && i>0; j++){
+            dot += data[j]*key_quats[key_quats.size() - 4 + j];
+        }
+        T sign = dot < 0 ? -1 : 1;
+        key_times.push_back(times[i]);
+        for(int j=0; j<4; j++){
+            key_quats.push_back(sign*data[j]);
+        }
+    }
+
+    // Squad Control Points s[i] = q[i]*exp(-(log(q[i]^-1*q[i+1]) + log(q[i]^-1*q[i-1]))/4)
+    for(size_t i=0; i<key_count; i++){
+        double key[4];
+        double control[4];
+        KeyDouble(first + i, key);
+        std::copy(key, key + 4, control);
+        if(i > 0 && i + 1 < key_count){
+            double previous[4];
+            double next[4];
+            double inverse[4] = {key[0], -key[1], -key[2], -key[3]};
+            KeyDouble(first + i - 1, previous);
+            KeyDouble(first + i + 1, next);
+
+            double to_next[4];
+            double to_previous[4];
+            double log_next[3];
+            double log_previous[3];
+            MultiplyDouble(inverse, next, to_next);
+            MultiplyDouble(inverse, previous, to_previous);
+            LogDouble(to_next, log_next);
+            LogDouble(to_previous, log_previous);
+
+            double tangent[3];
+            for(int j=0; j<3; j++){
+                tangent[j] = -0.25*(log_next[j] + log_previous[j]);
+            }
+            double exp_tangent[4];
+            ExpDouble(tangent, exp_tangent);
+            MultiplyDouble(key, exp_tangent, control);
+        }
+        for(int j=0; j<4; j++){
+            controls.push_back((T)control[j]);
+        }
+    }
+    return offsets.size() - 1;
+}
+
+size_t Size() const {return offsets.size();}
+
+size_t KeyCount(const size_t track) const {return counts[track];}
+
+// out[i] = Track i at time. Times Outside a Track Hold its First or Last Key
+void Sample(const float time, quaternion_array<T> &out, const interpolation mode = interpolate_slerp){
+    out.Resize(Size());
+    T *outputs[4] = {out.RawData(0), out.RawData(1), out.RawData(2), out.RawData(3)};
+    for(size_t block=0; block<Size(); block+=track_block_size){
+        const size_t count = std::min(track_block_size, Size() - block);
+        T *block_outputs[4];
+        for(int i=0; i<4; i++){
+            block_outputs[i] = outputs[i] + block;
+        }
+        SampleBlock(time, block, count, mode, block_outputs);
+    }
+}
+
+// One Track at time
+quaternion<T> Sample(const size_t track, const float time, const interpolation mode = interpolate_slerp){
+    if(track >= Size()){AGP_THROW("Track Out of Bounds");}
+    quaternion<T> return_quat;
+    T *data = return_quat.RawData();
+    T *outputs[4] = {data, data + 1, data + 2, data + 3};
+    SampleBlock(time, track, 1, mode, outputs);
+    return return_quat;
+}
+
+// Slerp by a Polynomial Instead of acos and sin (D. Eberly, "A Fast and
+// Accurate Algorithm for Computing SLERP"), Branchless so it Vectorizes.
+// 16 Terms With the Last Rescaled by mu Keep the Error Under 4e-8 Up to
+// 90 Degrees Apart in Quaternion Space. Takes the Short Path. q1, q2 and
+// out Point to w, x, y, z Component Arrays
+static void Slerp(const T * const *q1, const T * const *q2, const T *t, const size_t count, T * const *out){
+    SlerpKernel(q1[0], q1[1], q1[2], q1[3], q2[0], q2[1], q2[2], q2[3], t, count, out[0], out[1], out[2], out[3]);
+}
+
+// Branchless, Short Path nlerp
+static void Nlerp(const T * const *q1, const T * const *q2, const T *t, const size_t count, T * const *out){
+    NlerpKernel(q1[0], q1[1], q1[2], q1[3], q2[0], q2[1], q2[2], q2[3], t, count, out[0], out[1], out[2], out[3]);
+}
+
 
-        float vec[3] = { -delta_x*radius*sine, delta_y*radius*sine, radius*cosine - radius};
+private:
 
-        float vec2[3] = {delta_x*multiplier, delta_y*multiplier, - delta_y*sine};
+// Index of the Key Starting time's Segment, Relative to the Track's First Key
+size_t Segment(const size_t track, const float time){
+    const float *times = &key_times[offsets[track]];
+    const size_t last = counts[track] - 1;
+    if(last == 0){return 0;}
+
+    size_t cursor = cursors[track];
+    bool is_current = time >= times[cursor] && (time < times[cursor + 1] || cursor + 1 == last);
+    if(!is_current){
+        // Next Segment, Then Fall Back to a Search for Seeks
+        if(cursor + 1 < last && time >= times[cursor + 1] && (time < times[cursor + 2] || cursor + 2 == last)){
+            cursor++;
+        }
+        else{
+            size_t upper = std::upper_bound(times, times + last + 1, time) - times;
+            cursor = std::min(upper > 0 ? upper - 1 : 0, last - 1);
+        }
+        cursors[track] = cursor;
+    }
+    return cursor;
+}
 
-        // Multiply Transposed Basis Matrix by the Unit Vector and Add
-        for(int i=0; i<3; i++){
-            // Dumb Down the Code for Auto-Vectorization
-            for (int j=0; j<3; j++){
-                camera_pos[i] += basis[i + j*3]*vec[j];
-                up_vec[i] += basis[i + j*3]*vec2[j];
+void SampleBlock(const float time, const size_t begin, const size_t count, const interpolation mode, T * const *out){
+    T a[4][track_block_size];
+    T b[4][track_block_size];
+    T c[4][track_block_size];
+    T d[4][track_block_size];
+    T t[track_block_size];
+
+    // Gather Each Track's Segment Ends and Percentage
+    for(size_t i=0; i<count; i++){
+        const size_t track = begin + i;
+        const size_t segment = Segment(track, time);
+        const size_t key = offsets[track] + segment;
+        const size_t next = counts[track] > 1 ? key + 1 : key;
+        const float start = key_times[key];
+        const float length = key_times[next] - start;
+        float percentage = length > 0 ? (time - start)/length : 0;
+        t[i] = std::min(std::max(percentage, 0.0f), 1.0f);
+        for(int j=0; j<4; j++){
+            a[j][i] = key_quats[4*key + j];
+            b[j][i] = key_quats[4*next + j];
+        }
+        if(mode == interpolate_squad){
+            for(int j=0; j<4; j++){
+                c[j][i] = controls[4*key + j];
+                d[j][i] = controls[4*next + j];
             }
         }
     }
-}
 
+    const T *q1[4] = {a[0], a[1], a[2], a[3]};
+    const T *q2[4] = {b[0], b[1], b[2], b[3]};
+    switch(mode){
+        case interpolate_nlerp:
+            Nlerp(q1, q2, t, count, out);
+            break;
+        case interpolate_slerp:
+            Slerp(q1, q2, t, count, out);
+            break;
+        case interpolate_squad:{
+            // slerp(slerp(q1, q2, t), slerp(s1, s2, t), 2t(1 - t))
+            const T *s1[4] = {c[0], c[1], c[2], c[3]};
+            const T *s2[4] = {d[0], d[1], d[2], d[3]};
+            T key_path[4][track_block_size];
+            T control_path[4][track_block_size];
+            T *key_outputs[4] = {key_path[0], key_path[1], key_path[2], key_path[3]};
+            T *control_outputs[4] = {control_path[0], control_path[1], control_path[2], control_path[3]};
+            T h[track_block_size];
+            for(size_t i=0; i<count; i++){
+                h[i] = 2*t[i]*(1 - t[i]);
+            }
+            Slerp(q1, q2, t, count, key_outputs);
+            Slerp(s1, s2, t, count, control_outputs);
+            const T *key_inputs[4] = {key_path[0], key_path[1], key_path[2], key_path[3]};
+            const T *control_inputs[4] = {control_path[0], control_path[1], control_path[2], control_path[3]};
+            Slerp(key_inputs, control_inputs, h, count, out);
+            break;
+        }
+    }
+}
 
-void ViewProjMatrix(float *matrix){
-    // Create Basis to Local Space from Global Space... "View Matrix"
-    FormBasis();
+// Every Array is a Restrict Parameter so the Compiler Needs No Alias Checks
+static void SlerpKernel(const T * __restrict__ a0, const T * __restrict__ a1, const T * __restrict__ a2,
+const T * __restrict__ a3, const T * __restrict__ b0, const T * __restrict__ b1, const T * __restrict__ b2,
+const T * __restrict__ b3, const T * __restrict__ t, const size_t count,
+T * __restrict__ w, T * __restrict__ x, T * __restrict__ y, T * __restrict__ z){
+
+    // u[i] = 1/(n(2n + 1)), v[i] = n/(2n + 1) for n = i + 1
+    const T mu = 1.91666840;
+    const T u[16] = {1/(T)3, 1/(T)10, 1/(T)21, 1/(T)36, 1/(T)55, 1/(T)78, 1/(T)105, 1/(T)136,
+        1/(T)171, 1/(T)210, 1/(T)253, 1/(T)300, 1/(T)351, 1/(T)406, 1/(T)465, mu/528};
+    const T v[16] = {1/(T)3, 2/(T)5, 3/(T)7, 4/(T)9, 5/(T)11, 6/(T)13, 7/(T)15, 8/(T)17,
+        9/(T)19, 10/(T)21, 11/(T)23, 12/(T)25, 13/(T)27, 14/(T)29, 15/(T)31, mu*16/33};
+
+    for(size_t i=0; i<count; i++){
+        T dot = a0[i]*b0[i] + a1[i]*b1[i] + a2[i]*b2[i] + a3[i]*b3[i];
+        T sign = dot < 0 ? -1 : 1;
+        T x_minus_1 = sign*dot - 1;
+
+        T s = t[i];
+        T d = 1 - s;
+        T s_squared = s*s;
+        T d_squared = d*d;
+        T f_s = 1;
+        T f_d = 1;
+        for(int j=15; j>=0; j--){
+            f_s = 1 + f_s*(u[j]*s_squared - v[j])*x_minus_1;
+            f_d = 1 + f_d*(u[j]*d_squared - v[j])*x_minus_1;
+        }
+        f_s = sign*s*f_s;
+        f_d = d*f_d;
 
-    // Matrix Multiplication of View Matrix With the Sparse Projection Matrix
-    matrix[3] = -DotVec<3>(camera_pos, basis)*m00;
-    matrix[7] = -DotVec<3>(camera_pos, basis + 3)*m11;
-    matrix[15] = DotVec<3>(camera_pos, basis + 6);
-    matrix[11] = -matrix[15]*m22 + m32;
+        w[i] = f_d*a0[i] + f_s*b0[i];
+        x[i] = f_d*a1[i] + f_s*b1[i];
+        y[i] = f_d*a2[i] + f_s*b2[i];
+        z[i] = f_d*a3[i] + f_s*b3[i];
+    }
+}
 
-    for(int i=0; i<3; i++){
-        matrix[i] = basis[i]*m00;
-        matrix[i + 4] = basis[i + 3]*m11;
-        matrix[i + 8] = basis[i + 6]*m22;
-        matrix[i + 12] = -basis[i + 6];
+static void NlerpKernel(const T * __restrict__ a0, const T * __restrict__ a1, const T * __restrict__ a2,
+const T * __restrict__ a3, const T * __restrict__ b0, const T * __restrict__ b1, const T * __restrict__ b2,
+const T * __restrict__ b3, const T * __restrict__ t, const size_t count,
+T * __restrict__ w, T * __restrict__ x, T * __restrict__ y, T * __restrict__ z){
+    for(size_t i=0; i<count; i++){
+        T dot = a0[i]*b0[i] + a1[i]*b1[i] + a2[i]*b2[i] + a3[i]*b3[i];
+        T sign = dot < 0 ? -1 : 1;
+        T s = t[i];
+        T r0 = a0[i] + s*(sign*b0[i] - a0[i]);
+        T r1 = a1[i] + s*(sign*b1[i] - a1[i]);
+        T r2 = a2[i] + s*(sign*b2[i] - a2[i]);
+        T r3 = a3[i] + s*(sign*b3[i] - a3[i]);
+        T magnitude = 1/sqrt(r0*r0 + r1*r1 + r2*r2 + r3*r3);
+        w[i] = r0*magnitude;
+        x[i] = r1*magnitude;
+        y[i] = r2*magnitude;
+        z[i] = r3*magnitude;
     }
 }
 
+void KeyDouble(const size_t key, double *out) const {
+    for(int j=0; j<4; j++){
+        out[j] = key_quats[4*key + j];
+    }
+}
 
-private:
+static void MultiplyDouble(const double *q1, const double *q2, double *out){
+    out[0] = q1[0]*q2[0] - q1[1]*q2[1] - q1[2]*q2[2] - q1[3]*q2[3];
+    out[1] = q1[0]*q2[1] + q1[1]*q2[0] + q1[2]*q2[3] - q1[3]*q2[2];
+    out[2] = q1[0]*q2[2] - q1[1]*q2[3] + q1[2]*q2[0] + q1[3]*q2[1];
+    out[3] = q1[0]*q2[3] + q1[1]*q2[2] - q1[2]*q2[1] + q1[3]*q2[0];
+}
 
-void FormBasis(){
-    for (int i=0; i<3; i++){
-        basis[i + 6] = camera_pos[i] - center_pos[i];
+// Vector Part of the Log of a Unit Quaternion
+static void LogDouble(const double *q, double *out){
+    double magnitude = sqrt(q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    double scale = magnitude > 1e-12 ? atan2(magnitude, q[0])/magnitude : 0;
+    for(int j=0; j<3; j++){
+        out[j] = scale*q[j + 1];
     }
-    NormalizeVec<3>(basis + 6);
-    std::copy(up_vec, up_vec + 3, basis + 3);
-    CrossVec(basis + 3, basis + 6, basis);
-    NormalizeVec<3>(basis);
 }
 
-float basis[9];
+static void ExpDouble(const double *vec, double *out){
+    double magnitude = sqrt(vec[0]*vec[0] + vec[1]*vec[1] + vec[2]*vec[2]);
+    double scale = magnitude > 1e-12 ? sin(magnitude)/magnitude : 1;
+    out[0] = cos(magnitude);
+    for(int j=0; j<3; j++){
+        out[j + 1] = scale*vec[j];
+    }
+}
 
-float center_pos[3] = {0,0,0};
+std::vector<float> key_times;
 
-float camera_pos[3] = {0,1,0};
+// w, x, y, z of Each Key, Then of Each Squad Control Point
+std::vector<T> key_quats;
 
-float up_vec[3] = {0,0,1};
+std::vector<T> controls;
 
-float radius = 1;
+// Per Track: First Key, Key Count and Cached Segment
+std::vector<size_t> offsets;
 
-float aspect_ratio = 1;
+std::vector<size_t> counts;
 
-float pixel_to_wspace_x;
+std::vector<size_t> cursors;
 
-float pixel_to_wspace_y;
+};
 
-// Projection Matrix Values
-float m00 = 1/(aspect_ratio*tan(0.5*(40*3.14/180)));
 
-float m11 = 1/tan(0.5*(40*3.14/180));
 
-float m22 = (0.1 + 100)/(0.1 - 100);
+// Camera Recording File Layout, in the Writer's Native Byte Order so
+// arcball_replay Can Read Records in Place From the Mapped File:
+//   Header, recording_header_size Bytes: Magic "AGPCAM\0\0", uint32 Format
+//   Version, uint32 Record Size, uint32 Byte Order Mark 0x01020304, Padding
+//   Records, recording_record_size Bytes Each: double Timestamp, Then the 20
+//   floats of arcball_state in Declaration Order, Then Padding
+// Records are Fixed Size, so Frame i Starts at header + i*record Bytes. A
+// Recording From a Machine of the Other Byte Order Fails the Byte Order Mark
+const char recording_magic[8] = {'A', 'G', 'P', 'C', 'A', 'M', 0, 0};
 
-float m32 = 2*0.1*100/(0.1 - 100);
+const uint32_t recording_version = 1;
 
-};
+const size_t recording_header_size = 32;
 
+const size_t recording_record_size = 96;
 
+static_assert(sizeof(double) + sizeof(arcball_state) <= recording_record_size,
+    "arcball_state Doesn't Fit in a Recording Record");
 
-template <typename T> class quaternion{
 
-T quat[4] = {1,0,0,0};
+// Append Only Writer of arcball States. Records are Buffered and Written
+// in Large Blocks. A Recording Cut Short by a Crash Loses Only the Last
+// Partial Block and Stays Readable
+class arcball_recorder{
 
 public:
 
-
 // Constructors
-quaternion(){};
+arcball_recorder(){};
 
-quaternion(std::initializer_list<T> init){
-    std::copy(init.begin(), init.end(), quat);
-    Normalize();
+explicit arcball_recorder(const char *path){
+    Open(path);
 };
 
 
-// Destructor
-~quaternion(){};
-
-
-// Copy Constructor
-quaternion(const quaternion &q2){
-    std::copy(q2.quat, q2.quat + 4, quat);
-}
+// Destructor. A Failed Write Here Can't be Reported, Call Close() First
+// to Have it Throw
+~arcball_recorder(){
+    if(file){
+        WriteBuffer();
+        fclose(file);
+    }
+};
 
 
-// Operators
-T& operator[] (int pos){
-    if(pos > 0 || pos < 4){
-        return this->quat[pos];
-    }
-    else{
-        throw std::runtime_error("Index Out of Bounds");
-    }
-}
+// Member Functions
 
-void operator= (const quaternion &q2){
-    std::copy(q2.quat, q2.quat + 4, quat);
+void Open(const char *path){
+    Close();
+    file = fopen(path, "wb");
+    if(!file){AGP_THROW("Could Not Open Recording");}
+
+    char header[recording_header_size] = {0};
+    uint32_t fields[3] = {recording_version, (uint32_t)recording_record_size, 0x01020304};
+    memcpy(header, recording_magic, 8);
+    memcpy(header + 8, fields, sizeof(fields));
+    buffer.assign(header, header + recording_header_size);
+    frame_count = 0;
 }
-    
 
-// Ostream Print
-friend std::ostream& operator<< (std::ostream& os, const quaternion& qt){
-    os<<"["<<qt.quat[0]<<", "<<qt.quat[1]<<", "<<qt.quat[2]<<", "<<qt.quat[3]<<"]";
-    return os;
+void Record(const double timestamp, const arcball &arc){
+    arcball_state state;
+    arc.GetState(state);
+    Record(timestamp, state);
 }
 
+void Record(const double timestamp, const arcball_state &state){
+    if(!file){AGP_THROW("Recording Not Open");}
 
-// Member Functions
-
-// q_return = q1 * q2
-quaternion operator* (const quaternion &q2){
-    quaternion<T> return_quat;
-    return_quat[0] = quat[0]*q2.quat[0] - quat[1]*q2.quat[1] - quat[2]*q2.quat[2] - quat[3]*q2.quat[3];
-    return_quat[1] = quat[0]*q2.quat[1] + quat[1]*q2.quat[0] + quat[2]*q2.quat[3] - quat[3]*q2.quat[2];
-    return_quat[2] = quat[0]*q2.quat[2] - quat[1]*q2.quat[3] + quat[2]*q2.quat[0] + quat[3]*q2.quat[1];
-    return_quat[3] = quat[0]*q2.quat[3] + quat[1]*q2.quat[2] - quat[2]*q2.quat[1] + quat[3]*q2.quat[0];
+    size_t offset = buffer.size();
+    buffer.resize(offset + recording_record_size, 0);
+    memcpy(&buffer[offset], &timestamp, sizeof(double));
+    memcpy(&buffer[offset + sizeof(double)], &state, sizeof(arcball_state));
+    frame_count++;
 
-    return_quat.Normalize();
-    return return_quat;
+    if(buffer.size() >= buffer_size){Flush();}
 }
 
-// Returns Pointer To Quat Array
-T* RawData(){
-    return this->quat;
+void Flush(){
+    if(!WriteBuffer()){AGP_THROW("Could Not Write Recording");}
 }
 
-quaternion & Conj(){
-    for(int i=1; i<4; i++){
-        quat[i] = -quat[i];
-    }
-    return *this;
+void Close(){
+    if(!file){return;}
+    Flush();
+    fclose(file);
+    file = 0;
 }
 
-void Rotate(float *vec){
-    float q[3] = {quat[1], quat[2], quat[3]};
-    float qcrossr[3];
-    float qright[3];
+size_t FrameCount() const {return frame_count;}
 
-    CrossVec(q, vec, qcrossr);
 
-    for(int i=0; i<3; i++){
-        q[i] = 2*q[i];
-    }
-    CrossVec(q, qcrossr, qright);
+private:
 
-    for(int i=0; i<3; i++){
-        vec[i] += 2*quat[0]*qcrossr[i] + qright[i];
-    }
+static const size_t buffer_size = 1 << 16;
 
+// Returns false Instead of Throwing so the Destructor Can Use it
+bool WriteBuffer() noexcept {
+    if(!file || buffer.empty()){return true;}
+    if(fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()){return false;}
+    buffer.clear();
+    return fflush(file) == 0;
 }
 
+arcball_recorder(const arcball_recorder &);
 
-// Returns 4x4 Rotation Matrix
-void RotationMatrix4(T *matrix){
-    
-    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
-    matrix[1] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
-    matrix[2] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
-    matrix[3] = 0;
-    matrix[4] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
-    matrix[5] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
-    matrix[6] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
-    matrix[7] = 0;
-    matrix[8] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
-    matrix[9] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
-    matrix[10] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
-    matrix[11] = 0;
-    matrix[12] = 0;
-    matrix[13] = 0;
-    matrix[14] = 0;
-    matrix[15] = 1; // 3, 3
-}
+arcball_recorder &operator=(const arcball_recorder &);
 
-// Returns 4x4 Rotation Matrix Transposed
-void RotationMatrix4T(T *matrix){
+FILE *file = 0;
 
-    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
-    matrix[1] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
-    matrix[2] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
-    matrix[3] = 0;
-    matrix[4] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
-    matrix[5] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
-    matrix[6] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
-    matrix[7] = 0;
-    matrix[8] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
-    matrix[9] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
-    matrix[10] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
-    matrix[11] = 0;
-    matrix[12] = 0;
-    matrix[13] = 0;
-    matrix[14] = 0;
-    matrix[15] = 1; // 3, 3
-}
+std::vector<char> buffer;
 
-// Returns 3x3 Rotation Matrix
-void RotationMatrix3(T *matrix){
+size_t frame_count = 0;
 
+};
 
-    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
-    matrix[1] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
-    matrix[2] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
-    matrix[3] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
-    matrix[4] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
-    matrix[5] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
-    matrix[6] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
-    matrix[7] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
-    matrix[8] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
-}
 
-// Returns 3x3 Rotation Matrix Transposed
-void RotationMatrix3T(T *matrix){
+// Only arcball_replay Uses These, AGP_MMAP is Undefined Again After it
+#if defined(__unix__) || defined(__APPLE__)
+#define AGP_MMAP
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+#endif
 
-    matrix[0] = 2*(quat[0]*quat[0] + quat[1]*quat[1]) - 1; // 0,0
-    matrix[1] = 2*(quat[1]*quat[2] + quat[0]*quat[3]);     // 1,0
-    matrix[2] = 2*(quat[1]*quat[3] - quat[0]*quat[2]);     // 2,0
-    matrix[3] = 2*(quat[1]*quat[2] - quat[0]*quat[3]);     // 0,1
-    matrix[4] = 2*(quat[0]*quat[0] + quat[2]*quat[2]) - 1; // 1,1
-    matrix[5] = 2*(quat[2]*quat[3] + quat[0]*quat[1]);     // 2,1
-    matrix[6] = 2*(quat[1]*quat[3] + quat[0]*quat[2]);     // 0,2
-    matrix[7] = 2*(quat[2]*quat[3] - quat[0]*quat[1]);     // 1,2
-    matrix[8] = 2*(quat[0]*quat[0] + quat[3]*quat[3]) - 1; // 2,2
-}
 
+// Reads a Recording Through a Read Only Memory Map (Whole File Read on
+// Platforms Without mmap). Any Frame is Found in O(1) From its Index, and
+// Replaying it Into an arcball Allocates Nothing
+class arcball_replay{
 
-// Sets Quaternion With Euler Angles
-// Angles must be in radians
-// NASA ZYX Rotation Order
-void SetWithEuler(float roll/*x*/, float pitch/*y*/, float yaw/*z*/){
-    T cos_z = cos(0.5*yaw);
-    T sin_z = sin(0.5*yaw);
-    T cos_y = cos(0.5*pitch);
-    T sin_y = sin(0.5*pitch);
-    T cos_x = cos(0.5*roll);
-    T sin_x = sin(0.5*roll);
+public:
 
-    T cxcy = cos_x * cos_y;
-    T sxsy = sin_x * sin_y;
-    T sxcy = sin_x * cos_y;
-    T cxsy = cos_x * sin_y;
+// Constructors
+arcball_replay(){};
 
-    quat[0] = cxcy * cos_z + sxsy * sin_z;
-    quat[1] = sxcy * cos_z - cxsy * sin_z;
-    quat[2] = cxsy * cos_z + sxcy * sin_z;
-    quat[3] = cxcy * sin_z - sxsy * cos_z;
+explicit arcball_replay(const char *path){
+    Open(path);
+};
 
-    // Normalization
-    Normalize();
-}
 
-// Angles must be in radians
-// NASA ZYX Rotation Order
-void Euler(float *output){
+// Destructor
+~arcball_replay(){
+    Close();
+};
 
-	T cross = quat[0]*quat[2] - quat[3]*quat[1];
 
-    // Aligned With Positive Z-axis
-	if(cross > 0.49999){
-        output[0] = 2*atan2(quat[1], quat[0]);
-		output[1] = 1.57079632679;
-		output[2] = 0;
-		return;
-	}
+// Member Functions
 
-    // Aligned With Negative Z-axis
-	else if(cross < -0.49999){
-        output[0] = 2*atan2(quat[1], quat[0]);
-		output[1] = -1.57079632679;
-		output[2] = 0;
-		return;
-	}
-    
+void Open(const char *path){
+    Close();
+#ifdef AGP_MMAP
+    int descriptor = open(path, O_RDONLY);
+    if(descriptor < 0){AGP_THROW("Could Not Open Recording");}
+    struct stat file_stat;
+    if(fstat(descriptor, &file_stat) != 0){
+        close(descriptor);
+        AGP_THROW("Could Not Open Recording");
+    }
+    size = file_stat.st_size;
+    if(size > 0){
+        void *mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if(mapping == MAP_FAILED){AGP_THROW("Could Not Map Recording");}
+        data = (const char*)mapping;
+    }
     else{
-        output[0] = atan2(2*(quat[0]*quat[1] + quat[2]*quat[3]) , 1 - 2*(quat[1]*quat[1] + quat[2]*quat[2]));
-        output[1] = asin(2*cross);
-        output[2] = atan2(2*(quat[0]*quat[3] + quat[1]*quat[2]) , 1 - 2*(quat[2]*quat[2] + quat[3]*quat[3]));
-        return;
+        close(descriptor);
     }
+#else
+    FILE *file = fopen(path, "rb");
+    if(!file){AGP_THROW("Could Not Open Recording");}
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    contents.resize(size);
+    size_t read_size = size > 0 ? fread(&contents[0], 1, size, file) : 0;
+    fclose(file);
+    if(read_size != size){AGP_THROW("Could Not Read Recording");}
+    data = contents.data();
+#endif
+
+    uint32_t fields[3] = {0, 0, 0};
+    if(size >= recording_header_size){memcpy(fields, data + 8, sizeof(fields));}
+    if(size < recording_header_size || memcmp(data, recording_magic, 8) != 0 ||
+        (fields[2] != 0x01020304 && fields[2] != 0x04030201)){
+        Close();
+        AGP_THROW("Not a Camera Recording");
+    }
+    if(fields[2] != 0x01020304){
+        Close();
+        AGP_THROW("Recording Has the Other Byte Order");
+    }
+    if(fields[0] != recording_version || fields[1] != recording_record_size){
+        Close();
+        AGP_THROW("Unsupported Recording Version");
+    }
+
+    // A Trailing Partial Record is Ignored
+    frame_count = (size - recording_header_size)/recording_record_size;
 }
 
+void Close(){
+#ifdef AGP_MMAP
+    if(data){munmap((void*)data, size);}
+#else
+    std::vector<char>().swap(contents);
+#endif
+    data = 0;
+    size = 0;
+    frame_count = 0;
+}
 
-// returns nlerp Quaternion From q1 To q2 by Percentage t Between 0 and 1
-void nlerp(quaternion &q1, quaternion &q2, float t){
+size_t FrameCount() const {return frame_count;}
 
-        if(t < 0 || t > 1){throw std::runtime_error("Out of Bounds Percentage");};
+double Timestamp(const size_t frame) const {
+    double timestamp;
+    memcpy(&timestamp, Record(frame), sizeof(double));
+    return timestamp;
+}
 
-        float angle = 0;
-        for(int i=0; i<4; i++){
-            angle += q1[i]*q2[i];
-        }
+void State(const size_t frame, arcball_state &state) const {
+    memcpy(&state, Record(frame) + sizeof(double), sizeof(arcball_state));
+}
 
-        if(angle < 0.0){
-            if(angle < -0.999){throw std::runtime_error("nlerp Undefined at 180 Degrees");}
-            for(int i=0; i<4; i++){
-                quat[i] = q1[i] - t*(q1[i] + q2[i]);
-            }
-        }
-        else{
-            for(int i=0; i<4; i++){
-                quat[i] = q1[i] - t*(q1[i] - q2[i]);
-            }
-        }
-        
-        Normalize();
+// Restores the Frame so arc.ViewProjMatrix() Matches the Recorded Camera Exactly
+void Frame(const size_t frame, arcball &arc) const {
+    arcball_state state;
+    State(frame, state);
+    arc.SetState(state);
 }
 
+// Last Frame at or Before timestamp, or 0. Timestamps Must be Recorded in Order
+size_t FrameAt(const double timestamp) const {
+    size_t low = 0;
+    size_t high = frame_count;
+    while(high - low > 1){
+        size_t middle = low + (high - low)/2;
+        if(Timestamp(middle) <= timestamp){low = middle;}
+        else{high = middle;}
+    }
+    return low;
+}
 
-private: 
 
-// Normalize Internal Quat Array
-void Normalize(){
-    T magnitude = 0;
-    for (int i=0; i<4; i++){
-        magnitude += quat[i]*quat[i];
-    }
-    magnitude = 1/sqrt(magnitude);
-    for (int i=0; i<4; i++){
-        quat[i] = quat[i]*magnitude;
-    }
+private:
+
+const char *Record(const size_t frame) const {
+    if(frame >= frame_count){AGP_THROW("Frame Out of Bounds");}
+    return data + recording_header_size + frame*recording_record_size;
 }
 
+arcball_replay(const arcball_replay &);
+
+arcball_replay &operator=(const arcball_replay &);
+
+const char *data = 0;
+
+size_t size = 0;
+
+size_t frame_count = 0;
+
+#ifndef AGP_MMAP
+std::vector<char> contents;
+#endif
+
 };
 
+#undef AGP_MMAP
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,664 @@
+// Copyright (c) 2021 Matthew Elks
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Benchmarks Every Kernel in agp.h and Writes the Results as JSON
+// Usage: bench_agp_h [output.json] [seconds per benchmark]
+
+
+#include"../libs/agp/agp.h"
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<cstdlib>
+
+
+struct bench_result{
+    std::string name;
+    std::string type;
+    size_t batch;
+    size_t iterations;
+    double ns_per_op;
+    double ops_per_s;
+};
+
+
+std::vector<bench_result> results;
+
+double min_seconds = 0.2;
+
+
+// Keeps the Compiler From Removing Work Whose Result is Never Read
+template<typename T>
+void DoNotOptimize(T *pointer){
+    asm volatile("" : : "g"(pointer) : "memory");
+}
+
+
+// function() Performs batch Operations. Repeats it, Doubling the Count,
+// Until One Timed Run Lasts at Least min_seconds
+template<typename F>
+void Measure(const std::string &name, const std::string &type, const size_t batch, F function){
+    function(); // Warm Up
+
+    size_t iterations = 1;
+    double seconds = 0;
+    for(;;){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t i=0; i<iterations; i++){
+            function();
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(seconds >= min_seconds){break;}
+        iterations *= 2;
+    }
+
+    bench_result result;
+    result.name = name;
+    result.type = type;
+    result.batch = batch;
+    result.iterations = iterations;
+    result.ns_per_op = 1e9*seconds/((double)iterations*batch);
+    result.ops_per_s = (double)iterations*batch/seconds;
+    results.push_back(result);
+
+    std::cout<<name<<" ["<<type<<", batch "<<batch<<"]: "<<result.ns_per_op<<" ns/op, "
+        <<result.ops_per_s<<" ops/s\n";
+}
+
+
+void SetArcball(arcball &arc, const float offset){
+    float camera_position[3] = {1.41f + offset, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    arc.SetViewArea(1600, 900);
+    arc.SetProjectionVars(40*3.14/180, 0.1, 100);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+}
+
+
+const char *SimdLevelName(const simd_level level){
+    switch(level){
+        case simd_avx512: return "avx512";
+        case simd_avx2: return "avx2";
+        case simd_sse2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+
+void BenchmarkArcball(){
+    arcball arc;
+    SetArcball(arc, 0);
+    float matrix[16];
+    float ray[3];
+
+    // Opposite Deltas Keep the Camera Near its Start
+    float sign = 1;
+    Measure("arcball::Rotate", "float", 1, [&]{
+        arc.Rotate(4.4*sign, 5.3*sign);
+        sign = -sign;
+    });
+    Measure("arcball::Rotate<math_fast>", "float", 1, [&]{
+        arc.Rotate<math_fast>(4.4*sign, 5.3*sign);
+        sign = -sign;
+    });
+    Measure("arcball::Rotate<math_approximate>", "float", 1, [&]{
+        arc.Rotate<math_approximate>(4.4*sign, 5.3*sign);
+        sign = -sign;
+    });
+    Measure("arcball::Translate", "float", 1, [&]{
+        arc.Translate(4.4*sign, 5.3*sign);
+        sign = -sign;
+    });
+    arcball_inertia inertia;
+    inertia.rest_speed = 0;
+    inertia.damping = 0;
+    Measure("arcball_inertia::Update", "float", 1, [&]{
+        inertia.rotate_velocity[0] = 300*sign;
+        inertia.rotate_velocity[1] = -120*sign;
+        inertia.Update(arc, 1.0f/60);
+        sign = -sign;
+    });
+    Measure("arcball::SetRadius", "float", 1, [&]{
+        arc.SetRadius(arc.Radius() + 0.5*sign);
+        sign = -sign;
+    });
+    Measure("arcball::TrySetRadius", "float", 1, [&]{
+        arc.TrySetRadius(arc.Radius() + 0.5*sign);
+        sign = -sign;
+    });
+    Measure("arcball::Zoom", "float", 1, [&]{
+        arc.Zoom(4.4, 5.3, 0.5*sign);
+        sign = -sign;
+    });
+    Measure("arcball::ViewProjMatrix", "float", 1, [&]{
+        arc.ViewProjMatrix(matrix);
+        DoNotOptimize(matrix);
+    });
+    Measure("arcball::MouseRay", "float", 1, [&]{
+        arc.MouseRay(3.7, 6.9, ray);
+        DoNotOptimize(ray);
+    });
+
+    // One Mouse Event per Frame
+    Measure("arcball::Rotate + ViewProjMatrix", "float", 1, [&]{
+        arc.Rotate(4.4*sign, 5.3*sign);
+        arc.ViewProjMatrix(matrix);
+        DoNotOptimize(matrix);
+        sign = -sign;
+    });
+
+    quaternion_arcball quat_arc;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    quat_arc.SetViewArea(1600, 900);
+    quat_arc.SetCamera(camera_position, up_vec);
+    Measure("quaternion_arcball::Rotate", "float", 1, [&]{
+        quat_arc.Rotate(4.4*sign, 5.3*sign);
+        sign = -sign;
+    });
+    Measure("quaternion_arcball::Rotate + ViewProjMatrix", "float", 1, [&]{
+        quat_arc.Rotate(4.4*sign, 5.3*sign);
+        quat_arc.ViewProjMatrix(matrix);
+        DoNotOptimize(matrix);
+        sign = -sign;
+    });
+}
+
+
+// One 4K Frame of Rays, per Pixel and per Packet
+void BenchmarkMouseRays(){
+    arcball arc;
+    SetArcball(arc, 0);
+    const size_t width = 3840;
+    const size_t height = 2160;
+    std::vector<float> dir_x(width*height);
+    std::vector<float> dir_y(width*height);
+    std::vector<float> dir_z(width*height);
+    std::vector<float> packets(3*width*height);
+    float ray[3];
+
+    Measure("arcball::MouseRay (4K Frame)", "float", width*height, [&]{
+        for(size_t row=0; row<height; row++){
+            for(size_t column=0; column<width; column++){
+                arc.MouseRay(1920.0f - column, 1080.0f - row, ray);
+                dir_x[row*width + column] = ray[0];
+                dir_y[row*width + column] = ray[1];
+                dir_z[row*width + column] = ray[2];
+            }
+        }
+        DoNotOptimize(dir_x.data());
+    });
+    Measure("arcball::MouseRays (4K Frame)", "float", width*height, [&]{
+        arc.MouseRays(1920, 1080, width, height, dir_x.data(), dir_y.data(), dir_z.data(), width);
+        DoNotOptimize(dir_x.data());
+    });
+    Measure("arcball::MouseRayPackets (4K Frame)", "float", width*height, [&]{
+        arc.MouseRayPackets(1920, 1080, width, height, packets.data());
+        DoNotOptimize(packets.data());
+    });
+
+    // Every Eighth Pixel at the Far Plane. The Sink Only Counts Points
+    std::vector<float> depth(width*height);
+    for(size_t i=0; i<depth.size(); i++){
+        depth[i] = i % 8 == 0 ? 1 : 0.9f + 0.0001f*(i % 997);
+    }
+    struct count_sink{
+        std::atomic<size_t> count;
+        void operator()(const float *x, const float *, const float *, const uint32_t *, const size_t size){
+            DoNotOptimize(x);
+            count += size;
+        }
+    } sink;
+    Measure("arcball::DepthPoints (4K Frame)", "float", width*height, [&]{
+        sink.count = 0;
+        arc.DepthPoints(1920, 1080, width, height, depth.data(), width, sink);
+    });
+}
+
+
+void BenchmarkArcballBatch(const size_t batch){
+    std::vector<arcball> arcs(batch);
+    arcball_batch arc_batch;
+    for(size_t i=0; i<batch; i++){
+        SetArcball(arcs[i], 0.001*i);
+        arc_batch.Add(arcs[i]);
+    }
+    std::vector<float> matrices(16*batch);
+
+    float sign = 1;
+    Measure("arcball::Rotate + ViewProjMatrix", "float", batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            arcs[i].Rotate(4.4*sign, 5.3*sign);
+            arcs[i].ViewProjMatrix(&matrices[16*i]);
+        }
+        sign = -sign;
+        DoNotOptimize(matrices.data());
+    });
+    Measure("arcball_batch::Update", "float", batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            arc_batch.QueueRotate(i, 4.4*sign, 5.3*sign);
+        }
+        arc_batch.Update(matrices.data());
+        sign = -sign;
+        DoNotOptimize(matrices.data());
+    });
+    Measure("arcball_batch::Update (Nothing Queued)", "float", batch, [&]{
+        arc_batch.Update();
+        DoNotOptimize(&arc_batch);
+    });
+    arcball_inertia_batch inertia;
+    inertia.Resize(batch);
+    inertia.rest_speed = 0;
+    inertia.damping = 0;
+    for(size_t i=0; i<batch; i++){
+        inertia.AddRotate(i, 300, -120);
+    }
+    Measure("arcball_inertia_batch::Update + arcball_batch::Update", "float", batch, [&]{
+        inertia.Update(arc_batch, 1.0f/60);
+        arc_batch.Update(matrices.data());
+        DoNotOptimize(matrices.data());
+    });
+    Measure("arcball_batch::ViewProjMatrices (Column Major)", "float", batch, [&]{
+        arc_batch.ViewProjMatrices(matrices.data(), 16, column_major);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("arcball_batch::ViewProjMatrices (Column Major, Streamed)", "float", batch, [&]{
+        arc_batch.ViewProjMatrices(matrices.data(), 16, column_major, true);
+        DoNotOptimize(matrices.data());
+    });
+}
+
+
+void BenchmarkMat4(const size_t batch){
+    std::vector<float> models(16*batch);
+    std::vector<float> output(16*batch);
+    float viewproj[16] = {4, 6, 4, 3, 5, 5, 6, 7, 6, 4, 5, 4, 7, 3, 9, 0};
+    for(size_t i=0; i<models.size(); i++){
+        models[i] = 0.01*(i % 97);
+    }
+
+    for(int level=simd_scalar; level<=SimdLevel(); level++){
+        mat4_multiply_kernel multiply = Mat4MultiplyMat4TKernel((simd_level)level);
+        mat4_transpose_kernel transpose = TransposeMat4Kernel((simd_level)level);
+        std::string suffix = std::string(" (") + SimdLevelName((simd_level)level) + ")";
+
+        Measure("Mat4MultiplyMat4T" + suffix, "float", batch, [&]{
+            for(size_t i=0; i<batch; i++){
+                multiply(&models[16*i], viewproj, &output[16*i]);
+            }
+            DoNotOptimize(output.data());
+        });
+        Measure("TransposeMat4" + suffix, "float", batch, [&]{
+            for(size_t i=0; i<batch; i++){
+                transpose(&models[16*i], &output[16*i]);
+            }
+            DoNotOptimize(output.data());
+        });
+    }
+
+    Measure("Mat4MultiplyMat4TBatch", "float", batch, [&]{
+        Mat4MultiplyMat4TBatch(models.data(), viewproj, output.data(), batch);
+        DoNotOptimize(output.data());
+    });
+    Measure("Mat4MultiplyMat4TBatch (Thread Pool)", "float", batch, [&]{
+        Mat4MultiplyMat4TBatch(models.data(), viewproj, output.data(), batch, DefaultThreadPool());
+        DoNotOptimize(output.data());
+    });
+}
+
+
+void BenchmarkVec(const size_t batch){
+    std::vector<float> vecs(3*batch);
+    std::vector<float> output(3*batch);
+    for(size_t i=0; i<vecs.size(); i++){
+        vecs[i] = 0.01*(i % 89) + 0.1;
+    }
+
+    Measure("NormalizeVec<3>", "float", batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            NormalizeVec<3>(&vecs[3*i]);
+        }
+        DoNotOptimize(vecs.data());
+    });
+    // Each Vector is Crossed With the Next, so the Last Has no Partner
+    Measure("CrossVec", "float", batch - 1, [&]{
+        for(size_t i=0; i+1<batch; i++){
+            CrossVec(&vecs[3*i], &vecs[3*i + 3], &output[3*i]);
+        }
+        DoNotOptimize(output.data());
+    });
+}
+
+
+template<typename T>
+void BenchmarkQuaternion(const char *type, const size_t batch){
+    std::vector<quaternion<T> > q1(batch);
+    std::vector<quaternion<T> > q2(batch);
+    std::vector<quaternion<T> > output(batch);
+    quaternion_array<T> array1(batch);
+    quaternion_array<T> array2(batch);
+    quaternion_array<T> array_output(batch);
+    for(size_t i=0; i<batch; i++){
+        q1[i].SetWithEuler(0.001*i, -1.1, 2.1);
+        q2[i].SetWithEuler(0.6, 0.002*i, -0.3);
+        array1.Set(i, q1[i]);
+        array2.Set(i, q2[i]);
+    }
+    std::vector<T> matrices(16*batch);
+    std::vector<float> angles(3*batch);
+    std::vector<float> points(3*batch, 1);
+
+    Measure("quaternion::operator*", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            output[i] = q1[i] * q2[i];
+        }
+        DoNotOptimize(output.data());
+    });
+    Measure("quaternion::SetWithEuler", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            output[i].SetWithEuler(0.6, -2.2, 0.001*i);
+        }
+        DoNotOptimize(output.data());
+    });
+    std::vector<quaternion<T, math_fast> > fast1(batch);
+    std::vector<quaternion<T, math_fast> > fast2(batch);
+    std::vector<quaternion<T, math_fast> > fast_output(batch);
+    Measure("quaternion<math_fast>::operator*", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            fast_output[i] = fast1[i] * fast2[i];
+        }
+        DoNotOptimize(fast_output.data());
+    });
+    Measure("quaternion<math_fast>::SetWithEuler", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            fast_output[i].SetWithEuler(0.6, -2.2, 0.001*i);
+        }
+        DoNotOptimize(fast_output.data());
+    });
+    Measure("quaternion::Euler", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            q1[i].Euler(&angles[3*i]);
+        }
+        DoNotOptimize(angles.data());
+    });
+    Measure("quaternion::RotationMatrix4", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            q1[i].RotationMatrix4(&matrices[16*i]);
+        }
+        DoNotOptimize(matrices.data());
+    });
+    Measure("quaternion::Rotate", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            q1[i].Rotate(&points[3*i]);
+        }
+        DoNotOptimize(points.data());
+    });
+    Measure("quaternion::nlerp", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            output[i].nlerp(q1[i], q2[i], 0.3);
+        }
+        DoNotOptimize(output.data());
+    });
+    Measure("quaternion::TryNlerp", type, batch, [&]{
+        for(size_t i=0; i<batch; i++){
+            output[i].TryNlerp(q1[i], q2[i], 0.3);
+        }
+        DoNotOptimize(output.data());
+    });
+
+    Measure("quaternion_array::Multiply", type, batch, [&]{
+        array_output.Multiply(array1, array2);
+        DoNotOptimize(array_output.RawData(0));
+    });
+    Measure("quaternion_array::RotationMatrix4", type, batch, [&]{
+        array1.RotationMatrix4(matrices.data());
+        DoNotOptimize(matrices.data());
+    });
+    Measure("quaternion_array::RotationMatrix4 (Column Major, Streamed)", type, batch, [&]{
+        array1.RotationMatrix4(matrices.data(), 16, column_major, true);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("quaternion_array::RotationMatrix4 (Thread Pool)", type, batch, [&]{
+        array1.RotationMatrix4(matrices.data(), DefaultThreadPool());
+        DoNotOptimize(matrices.data());
+    });
+    Measure("quaternion_array::Rotate (Thread Pool)", type, batch, [&]{
+        array1.Rotate(&points[0], &points[batch], &points[2*batch], DefaultThreadPool());
+        DoNotOptimize(points.data());
+    });
+    Measure("quaternion_array::nlerp", type, batch, [&]{
+        array_output.nlerp(array1, array2, 0.3);
+        DoNotOptimize(array_output.RawData(0));
+    });
+    std::vector<float> roll(batch), pitch(batch), yaw(batch);
+    array1.Euler(roll.data(), pitch.data(), yaw.data());
+    Measure("quaternion_array::SetWithEuler", type, batch, [&]{
+        array_output.SetWithEuler(roll.data(), pitch.data(), yaw.data(), batch);
+        DoNotOptimize(array_output.RawData(0));
+    });
+    Measure("quaternion_array::Euler", type, batch, [&]{
+        array1.Euler(roll.data(), pitch.data(), yaw.data());
+        DoNotOptimize(roll.data());
+    });
+}
+
+
+// batch Tracks of 8 Keys Played Forward, One Sample per Call
+template<typename T>
+void BenchmarkTracks(const char *type, const size_t batch){
+    const int key_count = 8;
+    float times[key_count];
+    quaternion<T> keys[key_count];
+    for(int i=0; i<key_count; i++){
+        times[i] = i;
+        keys[i].SetWithEuler(0.3*i, -0.2*i, 0.5*i);
+    }
+    quaternion_tracks<T> tracks;
+    for(size_t i=0; i<batch; i++){
+        tracks.Add(times, keys, key_count);
+    }
+    quaternion_array<T> out(batch);
+
+    const char *names[3] = {"quaternion_tracks::Sample (nlerp)", "quaternion_tracks::Sample (slerp)", "quaternion_tracks::Sample (squad)"};
+    const interpolation modes[3] = {interpolate_nlerp, interpolate_slerp, interpolate_squad};
+    for(int i=0; i<3; i++){
+        float time = 0;
+        Measure(names[i], type, batch, [&]{
+            tracks.Sample(time, out, modes[i]);
+            time = time > key_count ? 0 : time + 0.01f;
+            DoNotOptimize(out.RawData(0));
+        });
+    }
+}
+
+
+void BenchmarkRotatePoints(const size_t batch){
+    quaternion<float> quat = {-1, 3, 4, 3};
+    std::vector<float> points(3*batch, 1);
+
+    Measure("RotatePoints", "float", batch, [&]{
+        RotatePoints(quat, points.data(), points.data(), batch);
+        DoNotOptimize(points.data());
+    });
+
+    arcball arc;
+    SetArcball(arc, 0);
+    float inverse[16];
+    arc.InverseViewProjMatrix(inverse);
+    std::vector<float> ndc(3*batch), world(3*batch);
+    for(size_t i=0; i<batch; i++){
+        ndc[i] = 0.0001*(i % 10007) - 0.5;
+        ndc[batch + i] = 0.5 - 0.0001*(i % 9973);
+        ndc[2*batch + i] = 0.9;
+    }
+    Measure("UnprojectPoints", "float", batch, [&]{
+        UnprojectPoints(inverse, &ndc[0], &ndc[batch], &ndc[2*batch], &world[0], &world[batch], &world[2*batch], batch);
+        DoNotOptimize(world.data());
+    });
+}
+
+
+// Random Small Triangles Filling a 100 Unit Cube
+void BenchmarkBvh(const size_t batch){
+    std::vector<float> triangles(9*batch);
+    for(size_t i=0; i<batch; i++){
+        float center[3] = {(float)(rand() % 1000)*0.1f, (float)(rand() % 1000)*0.1f, (float)(rand() % 1000)*0.1f};
+        for(int j=0; j<9; j++){
+            triangles[9*i + j] = center[j % 3] + (float)(rand() % 100)*0.005f;
+        }
+    }
+
+    bvh tree;
+    Measure("bvh::BuildTriangles", "float", batch, [&]{
+        tree.BuildTriangles(triangles.data(), batch);
+    });
+
+    arcball arc;
+    float camera_position[3] = {150, 120, 130};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {50, 50, 50};
+    arc.SetViewArea(1600, 900);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+    bvh_hit hit;
+    int mouse = 0;
+    Measure("bvh::Pick", "float", 1, [&]{
+        tree.Pick(arc, (float)(mouse % 200 - 100), (float)(mouse % 150 - 75), hit);
+        mouse += 7;
+        DoNotOptimize(&hit);
+    });
+
+    std::vector<size_t> changed;
+    for(size_t i=0; i<batch; i+=64){
+        changed.push_back(i);
+    }
+    Measure("bvh::Refit (Every 64th Triangle)", "float", changed.size(), [&]{
+        tree.Refit(changed.data(), changed.size());
+    });
+    Measure("bvh::Refit", "float", batch, [&]{
+        tree.Refit();
+    });
+}
+
+
+// Objects Scattered Around the Camera, Roughly a Tenth Visible
+void BenchmarkCulling(const size_t batch){
+    arcball arc;
+    SetArcball(arc, 0);
+    float planes[24];
+    Measure("arcball::FrustumPlanes", "float", 1, [&]{
+        arc.FrustumPlanes(planes);
+        DoNotOptimize(planes);
+    });
+
+    std::vector<float> min_x(batch), min_y(batch), min_z(batch);
+    std::vector<float> max_x(batch), max_y(batch), max_z(batch);
+    std::vector<float> radius(batch);
+    for(size_t i=0; i<batch; i++){
+        min_x[i] = (float)(rand() % 2000)*0.01f - 10;
+        min_y[i] = (float)(rand() % 2000)*0.01f - 10;
+        min_z[i] = (float)(rand() % 2000)*0.01f - 10;
+        radius[i] = (float)(rand() % 100)*0.005f;
+        max_x[i] = min_x[i] + radius[i];
+        max_y[i] = min_y[i] + radius[i];
+        max_z[i] = min_z[i] + radius[i];
+    }
+    std::vector<uint32_t> visible(batch);
+
+    Measure("CullBoxes", "float", batch, [&]{
+        size_t count = CullBoxes(planes, min_x.data(), min_y.data(), min_z.data(),
+            max_x.data(), max_y.data(), max_z.data(), batch, visible.data());
+        DoNotOptimize(&count);
+    });
+    Measure("CullSpheres", "float", batch, [&]{
+        size_t count = CullSpheres(planes, min_x.data(), min_y.data(), min_z.data(), radius.data(), batch, visible.data());
+        DoNotOptimize(&count);
+    });
+}
+
+
+void BenchmarkRecording(){
+    const char *path = "bench_recording.agpr";
+    const size_t frames = 4096;
+    arcball arc;
+    SetArcball(arc, 0);
+
+    Measure("arcball_recorder::Record", "float", frames, [&]{
+        arcball_recorder recorder(path);
+        for(size_t i=0; i<frames; i++){
+            recorder.Record(0.01*i, arc);
+        }
+    });
+
+    arcball_replay replay(path);
+    float matrix[16];
+    Measure("arcball_replay::Frame", "float", frames, [&]{
+        for(size_t i=0; i<frames; i++){
+            replay.Frame(i, arc);
+            arc.ViewProjMatrix(matrix);
+            DoNotOptimize(matrix);
+        }
+    });
+    replay.Close();
+    std::remove(path);
+}
+
+
+void WriteJson(const char *path){
+    std::ofstream file(path);
+    file<<"{\n  \"simd_level\": \""<<SimdLevelName(SimdLevel())<<"\",\n";
+    file<<"  \"threads\": "<<DefaultThreadPool().Size()<<",\n";
+    file<<"  \"benchmarks\": [\n";
+    for(size_t i=0; i<results.size(); i++){
+        const bench_result &result = results[i];
+        file<<"    {\"name\": \""<<result.name<<"\", \"type\": \""<<result.type
+            <<"\", \"batch\": "<<result.batch<<", \"iterations\": "<<result.iterations
+            <<", \"ns_per_op\": "<<result.ns_per_op<<", \"ops_per_s\": "<<result.ops_per_s<<"}";
+        file<<(i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file<<"  ]\n}\n";
+}
+
+
+int main(int argc, char **argv){
+    const char *path = argc > 1 ? argv[1] : "bench_output.json";
+    if(argc > 2){min_seconds = atof(argv[2]);}
+
+    const size_t batches[3] = {64, 4096, 262144};
+
+    BenchmarkArcball();
+    BenchmarkMouseRays();
+    BenchmarkRecording();
+    for(int i=0; i<3; i++){
+        BenchmarkArcballBatch(batches[i]);
+        BenchmarkMat4(batches[i]);
+        BenchmarkVec(batches[i]);
+        BenchmarkQuaternion<float>("float", batches[i]);
+        BenchmarkQuaternion<double>("double", batches[i]);
+        BenchmarkTracks<float>("float", batches[i]);
+        BenchmarkTracks<double>("double", batches[i]);
+        BenchmarkRotatePoints(batches[i]);
+        BenchmarkBvh(batches[i]);
+        BenchmarkCulling(batches[i]);
+    }
+
+    WriteJson(path);
+    std::cout<<"Results Written to "<<path<<"\n";
+    return 0;
+}
@@ -20,7 +20,10 @@
 #include<iostream>
 #include<string>
 #include<sstream>
+#include<cstring>
+#include<fstream>
 #include<cmath>
+#include<chrono>
 
 
 TEST_CASE("MultiplyModelViewProj()"){
@@ -72,6 +75,236 @@ TEST_CASE("TransposeMat4()"){
 }
 
 
+TEST_CASE("Mat4 Kernels"){
+
+    float mat4_1[16] = {
+        1.34, 2.29, 3.21, 4.9,
+        3.33, 2.29, 1.135, 9.56,
+        4.78, 3.98, 2.11, 5.65,
+        1.11, 9.89, 5.12, 3.39};
+    float mat4_2[16] = {4, 6, 4, 3, 5, 5, 6, 7, 6, 4, 5, 4, 7, 3, 9, 0};
+
+    float expect_product[16];
+    float expect_transpose[16];
+    Mat4MultiplyMat4TScalar(mat4_1, mat4_2, expect_product);
+    TransposeMat4Scalar(mat4_1, expect_transpose);
+
+    // Every Level This CPU Supports
+    for(int level=simd_scalar; level<=SimdLevel(); level++){
+        float product[16];
+        float transpose[16];
+        Mat4MultiplyMat4TKernel((simd_level)level)(mat4_1, mat4_2, product);
+        TransposeMat4Kernel((simd_level)level)(mat4_1, transpose);
+
+        for(int i=0;i<16;i++){
+            CHECK(product[i] == expect_product[i]);
+            CHECK(transpose[i] == expect_transpose[i]);
+        }
+    }
+}
+
+
+TEST_CASE("Mat4MultiplyMat4TBatch()"){
+
+    float viewproj[16] = {4, 6, 4, 3, 5, 5, 6, 7, 6, 4, 5, 4, 7, 3, 9, 0};
+
+    SUBCASE("Strided Models"){
+        const int count = 9;
+        const int stride = 20;
+        float models[count*stride];
+        for(int i=0;i<count*stride;i++){
+            models[i] = 0.37*(i % 23) - 2.1;
+        }
+
+        float value[count*16];
+        Mat4MultiplyMat4TBatch(models, viewproj, value, count, stride);
+
+        for(int i=0;i<count;i++){
+            float expect[16];
+            Mat4MultiplyMat4T(models + i*stride, viewproj, expect);
+            for(int j=0;j<16;j++){
+                CHECK(value[i*16 + j] == expect[j]);
+            }
+        }
+    }
+
+    SUBCASE("Streamed Output"){
+        // Large Enough to Use Non-Temporal Stores
+        const size_t count = mat4_stream_threshold/(16*sizeof(float)) + 3;
+        std::vector<float> models(count*16);
+        std::vector<float> value(count*16 + 16);
+        for(size_t i=0;i<models.size();i++){
+            models[i] = 0.13*(i % 31) - 1.7;
+        }
+
+        // 64 Byte Aligned Destination Inside the Vector
+        float *aligned = value.data();
+        while((uintptr_t)aligned % 64 != 0){aligned++;}
+        Mat4MultiplyMat4TBatch(models.data(), viewproj, aligned, count);
+
+        bool is_equal = true;
+        for(size_t i=0;i<count;i++){
+            float expect[16];
+            Mat4MultiplyMat4T(models.data() + i*16, viewproj, expect);
+            for(int j=0;j<16;j++){
+                is_equal = is_equal && aligned[i*16 + j] == expect[j];
+            }
+        }
+        CHECK(is_equal);
+    }
+
+    SUBCASE("Thread Pool"){
+        // Streamed and Strided Batches Split Into Several Chunks
+        const size_t count = mat4_stream_threshold/(16*sizeof(float)) + 3;
+        const size_t stride = 20;
+        std::vector<float> models(count*stride);
+        for(size_t i=0;i<models.size();i++){
+            models[i] = 0.11*(i % 37) - 1.9;
+        }
+        thread_pool pool(3);
+
+        std::vector<float> expect(count*16 + 16), value(count*16 + 16);
+        float *aligned = value.data();
+        while((uintptr_t)aligned % 64 != 0){aligned++;}
+        Mat4MultiplyMat4TBatch(models.data(), viewproj, expect.data(), count, stride);
+        Mat4MultiplyMat4TBatch(models.data(), viewproj, aligned, count, pool, stride);
+        CHECK(std::equal(aligned, aligned + count*16, expect.data()));
+    }
+
+    SUBCASE("Every Kernel"){
+        float models[32];
+        for(int i=0;i<32;i++){
+            models[i] = 0.29*i - 3.3;
+        }
+        float expect[32];
+        Mat4MultiplyMat4TBatchScalar(models, 16, viewproj, expect, 16, 2, false);
+
+        for(int level=simd_scalar; level<=SimdLevel(); level++){
+            float value[32];
+            Mat4MultiplyMat4TBatchKernel((simd_level)level)(models, 16, viewproj, value, 16, 2, false);
+            for(int i=0;i<32;i++){
+                CHECK(value[i] == expect[i]);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("thread_pool"){
+
+    thread_pool pool(4);
+    CHECK(pool.Size() == 4);
+
+    SUBCASE("Every Index Once"){
+        const size_t counts[5] = {1, 7, 64, 1000, 100003};
+        const size_t chunk_sizes[4] = {1, 3, 64, 5000};
+        for(int i=0;i<5;i++){
+            for(int j=0;j<4;j++){
+                std::vector<std::atomic<int> > visits(counts[i]);
+                std::atomic<bool> is_aligned{true};
+                struct visit_job{
+                    std::vector<std::atomic<int> > &visits;
+                    std::atomic<bool> &is_aligned;
+                    size_t chunk_size;
+                    void operator()(const size_t begin, const size_t end){
+                        if(begin % chunk_size != 0){is_aligned = false;}
+                        for(size_t k=begin; k<end; k++){
+                            visits[k]++;
+                        }
+                    }
+                } job = {visits, is_aligned, chunk_sizes[j]};
+                pool.ParallelFor(counts[i], chunk_sizes[j], job);
+
+                bool is_once = true;
+                for(size_t k=0;k<counts[i];k++){
+                    is_once = is_once && visits[k] == 1;
+                }
+                CHECK(is_once);
+                CHECK(is_aligned);
+            }
+        }
+    }
+
+    SUBCASE("Uneven Work is Stolen"){
+        // All the Slow Chunks Start in the Caller's Range
+        const size_t count = 64;
+        std::vector<std::atomic<int> > visits(count);
+        struct uneven_job{
+            std::vector<std::atomic<int> > &visits;
+            void operator()(const size_t begin, const size_t end){
+                if(begin < 16){std::this_thread::sleep_for(std::chrono::milliseconds(2));}
+                for(size_t k=begin; k<end; k++){
+                    visits[k]++;
+                }
+            }
+        } job = {visits};
+        for(int repeat=0;repeat<3;repeat++){
+            pool.ParallelFor(count, 1, job);
+        }
+
+        bool is_thrice = true;
+        for(size_t k=0;k<count;k++){
+            is_thrice = is_thrice && visits[k] == 3;
+        }
+        CHECK(is_thrice);
+    }
+
+    SUBCASE("Nested Runs Serially"){
+        std::atomic<size_t> total{0};
+        struct inner_job{
+            std::atomic<size_t> &total;
+            void operator()(const size_t begin, const size_t end){
+                total += end - begin;
+            }
+        };
+        struct outer_job{
+            thread_pool &pool;
+            std::atomic<size_t> &total;
+            void operator()(const size_t begin, const size_t end){
+                for(size_t k=begin; k<end; k++){
+                    inner_job inner = {total};
+                    pool.ParallelFor(100, 10, inner);
+                }
+            }
+        } job = {pool, total};
+        pool.ParallelFor(50, 5, job);
+        CHECK(total == 5000);
+    }
+
+    SUBCASE("Exceptions Reach the Caller"){
+        // Chunk 0 Starts in the Caller's Range, Chunk 60 in a Worker's
+        const size_t throw_chunks[2] = {0, 60};
+        for(int i=0;i<2;i++){
+            struct throw_job{
+                size_t throw_chunk;
+                void operator()(const size_t begin, const size_t){
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    if(begin == throw_chunk){throw std::runtime_error("chunk");}
+                }
+            } job = {throw_chunks[i]};
+            CHECK_THROWS(pool.ParallelFor(64, 1, job));
+        }
+
+        // The Pool is Free Again, so Later Jobs Still Spread Across Threads
+        std::mutex mutex;
+        std::vector<std::thread::id> threads;
+        struct thread_job{
+            std::mutex &mutex;
+            std::vector<std::thread::id> &threads;
+            void operator()(const size_t, const size_t){
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                std::lock_guard<std::mutex> lock(mutex);
+                if(std::find(threads.begin(), threads.end(), std::this_thread::get_id()) == threads.end()){
+                    threads.push_back(std::this_thread::get_id());
+                }
+            }
+        } job = {mutex, threads};
+        pool.ParallelFor(64, 1, job);
+        CHECK(threads.size() > 1);
+    }
+}
+
+
 TEST_CASE("CrossVec3()"){
 
     float epsilon = 0.000001;
@@ -131,6 +364,159 @@ TEST_CASE("MagnitudeVec3()"){
 }
 
 
+TEST_CASE("Compile Time Math"){
+    // Evaluated by the Compiler
+    constexpr vec3 eye = {{5, -1.2, 0.0005}};
+    constexpr vec3 up = {{0, 0, 1}};
+    constexpr vec3 right = NormalizeVec(CrossVec(up, eye));
+    constexpr projection_matrix projection = PerspectiveProjection(1.2, 16.0/9, 0.5, 500);
+    constexpr quaternion<float> preset = quaternion<float>::FromEuler(0.3, -0.7, 2.1);
+    static_assert(DotVec(right, eye) < 1e-6 && DotVec(right, eye) > -1e-6, "Cross Product Not Orthogonal");
+    static_assert(preset.RawData()[0] > 0, "quaternion Not Constant");
+
+    SUBCASE("sqrt, sin, cos, tan"){
+        const double values[9] = {0, 1e-30, 0.25, 1, 2, 3.7, 1e3, 8e21, 1e300};
+        for(int i=0;i<9;i++){
+            CHECK(ConstSqrt(values[i]) == doctest::Approx(sqrt(values[i])).epsilon(1e-15));
+        }
+        CHECK(std::isnan(ConstSqrt(-1)));
+        for(double angle=-20; angle<20; angle+=0.173){
+            CHECK(fabs(ConstSin(angle) - sin(angle)) < 1e-12);
+            CHECK(fabs(ConstCos(angle) - cos(angle)) < 1e-12);
+        }
+        CHECK(ConstTan(0.7) == doctest::Approx(tan(0.7)).epsilon(1e-12));
+    }
+
+    SUBCASE("Vectors Match Run Time Versions"){
+        float expect[3];
+        float eye_copy[3] = {eye[0], eye[1], eye[2]};
+        CrossVec(up.data, eye_copy, expect);
+        NormalizeVec<3>(expect);
+        for(int i=0;i<3;i++){
+            CHECK(right[i] == doctest::Approx(expect[i]).epsilon(0.000001));
+        }
+        CHECK(MagnitudeVec(eye) == doctest::Approx(MagnitudeVec<3>(eye.data)).epsilon(0.000001));
+        vec3 diff = DiffVec(eye, up);
+        CHECK(diff[2] == doctest::Approx(-0.9995));
+    }
+
+    SUBCASE("Projection Matches SetProjectionVars()"){
+        arcball arc;
+        arc.SetViewArea(1600, 900);
+        arc.SetProjectionVars(1.2, 0.5, 500);
+        float expect[16];
+        arc.ViewProjMatrix(expect);
+        float expect_ray[3];
+        arc.MouseRay(100, 50, expect_ray);
+
+        arcball target;
+        target.SetViewArea(1600, 900);
+        target.SetProjection(projection);
+        float value[16];
+        target.ViewProjMatrix(value);
+        for(int i=0;i<16;i++){
+            CHECK(value[i] == doctest::Approx(expect[i]).epsilon(0.000001));
+        }
+        float ray[3];
+        target.MouseRay(100, 50, ray);
+        for(int i=0;i<3;i++){
+            CHECK(ray[i] == doctest::Approx(expect_ray[i]).epsilon(0.000001));
+        }
+
+        // Default Projection
+        CHECK(default_projection.m00 == doctest::Approx(1/tan(0.5*(40*3.14/180))).epsilon(0.0000001));
+        CHECK(default_projection.m32 == doctest::Approx(2*0.1*100/(0.1 - 100)).epsilon(0.0000001));
+    }
+
+    SUBCASE("FromEuler() Matches SetWithEuler()"){
+        quaternion<float> expect;
+        expect.SetWithEuler(0.3, -0.7, 2.1);
+        for(int i=0;i<4;i++){
+            CHECK(preset.RawData()[i] == doctest::Approx(expect[i]).epsilon(0.000001));
+        }
+        quaternion<double> value = quaternion<double>::FromValues(2, 0, 0, 0);
+        CHECK(value[0] == 1);
+    }
+}
+
+
+TEST_CASE_TEMPLATE("Math Policies", Math, math_precise, math_fast, math_approximate){
+
+    SUBCASE("RSqrt() and Sqrt()"){
+        for(double x=1e-30; x<1e30; x*=1.37){
+            float value = (float)x;
+            double expect = 1/sqrt((double)value);
+            CHECK(fabs(Math::RSqrt(value) - expect) <= Math::RSqrtError()*expect);
+            CHECK(fabs(Math::RSqrt((double)value) - expect) <= Math::RSqrtError()*expect);
+            CHECK(fabs(Math::Sqrt(value) - 1/expect) <= Math::RSqrtError()/expect);
+        }
+        CHECK(Math::Sqrt(0.0f) == 0);
+    }
+
+    SUBCASE("Sin() and Cos()"){
+        for(double x=-Math::TrigRange(); x<Math::TrigRange(); x+=Math::TrigRange()/4001){
+            float value = (float)x;
+            CHECK(fabs(Math::Sin(value) - sin((double)value)) <= Math::TrigError());
+            CHECK(fabs(Math::Cos(value) - cos((double)value)) <= Math::TrigError());
+        }
+        // Small Angles, Where Rotations Spend Most of Their Time
+        for(double x=-1; x<1; x+=0.000731){
+            CHECK(fabs(Math::Sin((float)x) - sin((double)(float)x)) <= Math::TrigError());
+            CHECK(fabs(Math::Cos((float)x) - cos((double)(float)x)) <= Math::TrigError());
+            CHECK(fabs(Math::Sin(x) - sin(x)) <= Math::TrigError());
+        }
+        CHECK(Math::Sin(0.0f) == 0);
+        CHECK(Math::Cos(0.0f) == 1);
+    }
+
+    SUBCASE("NormalizeVec()"){
+        float vec[3] = {5, -1.2, 0.0005};
+        NormalizeVec<3, Math>(vec);
+        CHECK(fabs(MagnitudeVec<3>(vec) - 1) <= Math::RSqrtError() + 1e-7);
+    }
+
+    SUBCASE("arcball::Rotate()"){
+        float camera_position[3] = {1.41, 2.05, 4.39};
+        float up_vec[3] = {0, 0, 1};
+        arcball precise;
+        arcball value;
+        precise.SetCamera(camera_position, up_vec);
+        value.SetCamera(camera_position, up_vec);
+        float radius = precise.Radius();
+
+        for(int i=0;i<20;i++){
+            float delta_x = 4.4*sin(0.3*i);
+            float delta_y = -5.3 + 0.7*i;
+            precise.Rotate(delta_x, delta_y);
+            value.Rotate<Math>(delta_x, delta_y);
+        }
+
+        // Each Step's Angle and Direction are Off by at Most the Policy's Errors
+        double tolerance = 20*radius*(Math::TrigError() + 0.03*Math::RSqrtError()) + 0.00001;
+        for(int i=0;i<3;i++){
+            CHECK(fabs(value.Camera()[i] - precise.Camera()[i]) <= tolerance);
+        }
+    }
+
+    SUBCASE("quaternion"){
+        quaternion<float, Math> value;
+        quaternion<float> expect;
+        value.SetWithEuler(0.3, -0.7, 2.1);
+        expect.SetWithEuler(0.3, -0.7, 2.1);
+        for(int i=0;i<4;i++){
+            CHECK(fabs(value[i] - expect[i]) <= 3*Math::TrigError() + Math::RSqrtError() + 1e-7);
+        }
+
+        quaternion<float, Math> other;
+        other.SetWithEuler(-1.1, 0.2, 0.5);
+        quaternion<float, Math> product = value*other;
+        float magnitude = 0;
+        for(int i=0;i<4;i++){magnitude += product[i]*product[i];}
+        CHECK(fabs(magnitude - 1) <= 2*Math::RSqrtError() + 1e-6);
+    }
+}
+
+
 TEST_CASE("Arcball"){
 
     auto set_arc_vars_functor = [&](arcball &arc){
@@ -354,6 +740,115 @@ TEST_CASE("Arcball"){
         }
     }
 
+    SUBCASE("Version() && Cached ViewProjMatrix()"){
+        arcball arc;
+        set_arc_vars_functor(arc);
+
+        float expect[16];
+        arc.ViewProjMatrix(expect);
+        unsigned version = arc.Version();
+
+        // Nothing Changed
+        float value[16];
+        arc.Rotate(0, 0);
+        arc.Translate(0, 0);
+        arc.ViewProjMatrix(value);
+        CHECK(arc.Version() == version);
+        for(int i=0;i<16;i++){
+            CHECK(value[i] == expect[i]);
+        }
+
+        arc.Rotate(4.4, 5.3);
+        CHECK(arc.Version() != version);
+        version = arc.Version();
+        arc.SetProjectionVars(40*3.14/180, 0.1, 20);
+        CHECK(arc.Version() != version);
+
+        // Translate and Zoom Bump the Version but Keep the Basis, Which is
+        // the Rotation Part of the Matrix
+        float before[16];
+        float after[16];
+        arc.ViewProjMatrix(before);
+        version = arc.Version();
+        arc.Translate(3, -2);
+        CHECK(arc.Version() != version);
+        version = arc.Version();
+        arc.Zoom(10, 20, -1);
+        CHECK(arc.Version() != version);
+        arc.ViewProjMatrix(after);
+        bool is_same_basis = true;
+        for(int i=0;i<4;i++){
+            is_same_basis = is_same_basis && memcmp(before + 4*i, after + 4*i, 3*sizeof(float)) == 0;
+        }
+        CHECK(is_same_basis);
+    }
+
+    SUBCASE("ViewProjMatrix() Layouts"){
+        arcball arc;
+        set_arc_vars_functor(arc);
+        float expect[16];
+        arc.ViewProjMatrix(expect);
+
+        // Aligned and Unaligned Destinations, Streamed or Not
+        alignas(16) float buffer[2][20];
+        for(int offset=0;offset<2;offset++){
+            for(int is_streamed=0;is_streamed<2;is_streamed++){
+                arc.ViewProjMatrix(buffer[0] + offset, row_major, is_streamed);
+                arc.ViewProjMatrix(buffer[1] + offset, column_major, is_streamed);
+                for(int i=0;i<4;i++){
+                    for(int j=0;j<4;j++){
+                        CHECK(buffer[0][offset + 4*i + j] == expect[4*i + j]);
+                        CHECK(buffer[1][offset + 4*j + i] == expect[4*i + j]);
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("InverseViewProjMatrix()"){
+        // Default Camera, Then SetCenter() Which Leaves the Up Row Off Perpendicular
+        arcball arcs[2];
+        set_arc_vars_functor(arcs[1]);
+        arcs[1].Rotate(4.4, 5.3);
+        for(int n=0;n<2;n++){
+            float viewproj[16];
+            float inverse[16];
+            float product[16];
+            float transposed[16];
+            arcs[n].ViewProjMatrix(viewproj);
+            arcs[n].InverseViewProjMatrix(inverse);
+            TransposeMat4(inverse, transposed);
+            Mat4MultiplyMat4T(viewproj, transposed, product);
+            for(int i=0;i<16;i++){
+                CHECK(fabs(product[i] - (i % 5 == 0 ? 1 : 0)) <= 0.00001);
+            }
+        }
+    }
+
+    SUBCASE("Consecutive Updates Use the Current Basis"){
+        arcball arc1;
+        arcball arc2;
+        set_arc_vars_functor(arc1);
+        set_arc_vars_functor(arc2);
+
+        float expect[16];
+        float value[16];
+        arc1.Rotate(4.4, 5.3);
+        arc1.ViewProjMatrix(expect);
+        arc1.Rotate(-2.1, 7.7);
+        arc1.Translate(4.4, 5.3);
+        arc1.ViewProjMatrix(expect);
+
+        arc2.Rotate(4.4, 5.3);
+        arc2.Rotate(-2.1, 7.7);
+        arc2.Translate(4.4, 5.3);
+        arc2.ViewProjMatrix(value);
+
+        for(int i=0;i<16;i++){
+            CHECK(value[i] == expect[i]);
+        }
+    }
+
     SUBCASE("MouseRay()"){
         arcball arc;
         set_arc_vars_functor(arc);
@@ -373,6 +868,354 @@ TEST_CASE("Arcball"){
 }
 
 
+TEST_CASE("arcball_batch"){
+
+    auto set_arc_vars_functor = [&](arcball &arc, float offset){
+        float camera_position[3] = {1.41f + offset, 2.05, 4.39};
+        float up_vec[3] = {0, 0, 1};
+        float center_position[3] = {0.3, 1.5f - offset, 0.083};
+        arc.rotate_sensitivity = 0.01;
+        arc.zoom_sensitivity = 0.9;
+        arc.SetViewArea(1600, 900);
+        arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+        arc.SetCamera(camera_position, up_vec);
+        arc.SetCenter(center_position);
+    };
+
+    SUBCASE("Update() && ViewProjMatrices()"){
+        const int count = 37;
+        arcball arcs[count];
+        arcball_batch batch;
+
+        for(int i=0;i<count;i++){
+            set_arc_vars_functor(arcs[i], 0.1*i);
+            CHECK(batch.Add(arcs[i]) == (size_t)i);
+        }
+        CHECK(batch.Size() == (size_t)count);
+
+        for(int i=0;i<count;i++){
+            float delta = 0.5*i - 4;
+            if(i % 2 == 0){
+                batch.QueueRotate(i, delta, 5.3);
+                arcs[i].Rotate(delta, 5.3);
+                float value[16];
+                arcs[i].ViewProjMatrix(value);
+            }
+            if(i % 3 == 0){
+                batch.QueueTranslate(i, 4.4, delta);
+                arcs[i].Translate(4.4, delta);
+            }
+            if(i % 5 == 0){
+                batch.QueueZoom(i, 4.4, 5.3, delta);
+                arcs[i].Zoom(4.4, 5.3, delta);
+            }
+        }
+
+        float values[16*count];
+        batch.Update(values);
+
+        for(int i=0;i<count;i++){
+            float expect[16];
+            arcs[i].ViewProjMatrix(expect);
+            for(int j=0;j<16;j++){
+                CHECK(values[16*i + j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+            }
+        }
+
+        // Deltas are Cleared After Update
+        float repeat[16*count];
+        batch.Update(repeat);
+        for(int i=0;i<16*count;i++){
+            CHECK(repeat[i] == values[i]);
+        }
+    }
+
+    SUBCASE("Several Deltas per Camera"){
+        const int count = 19;
+        arcball arcs[count];
+        arcball composed[count];
+        arcball_batch batch;
+        arcball_event_queue queue(64);
+        for(int i=0;i<count;i++){
+            set_arc_vars_functor(arcs[i], 0.1*i);
+            composed[i] = arcs[i];
+            batch.Add(arcs[i]);
+        }
+
+        float rotations[4][2] = {{1, 2}, {2, 1}, {0, 0}, {-1.5, 3}};
+        float zooms[4][3] = {{44, -53, -1}, {-20, 10, -2}, {44, -53, 0.5}, {10, 20, -0.25}};
+        for(int i=0;i<count;i++){
+            float offset = 0.05*i;
+            for(int j=0;j<4;j++){
+                batch.QueueRotate(i, rotations[j][0] + offset, rotations[j][1]);
+                arcs[i].Rotate(rotations[j][0] + offset, rotations[j][1]);
+                queue.PushRotate(rotations[j][0] + offset, rotations[j][1]);
+            }
+            queue.Drain(composed[i]);
+            for(int j=0;j<2;j++){
+                batch.QueueTranslate(i, 4.4, offset - j);
+                arcs[i].Translate(4.4, offset - j);
+                composed[i].Translate(4.4, offset - j);
+            }
+            for(int j=0;j<4;j++){
+                batch.QueueZoom(i, zooms[j][0], zooms[j][1] + offset, zooms[j][2]);
+                arcs[i].Zoom(zooms[j][0], zooms[j][1] + offset, zooms[j][2]);
+                composed[i].Zoom(zooms[j][0], zooms[j][1] + offset, zooms[j][2]);
+            }
+        }
+
+        float values[16*count];
+        batch.Update(values);
+
+        for(int i=0;i<count;i++){
+            // Composed Rotations are Rigid, Sequential Rotates Drift Slightly
+            float expect[16];
+            arcs[i].ViewProjMatrix(expect);
+            for(int j=0;j<16;j++){
+                CHECK(fabs(values[16*i + j] - expect[j]) < 0.002*(1 + fabs(expect[j])));
+            }
+
+            // Same Composition as arcball_event_queue
+            composed[i].ViewProjMatrix(expect);
+            for(int j=0;j<16;j++){
+                CHECK(values[16*i + j] == doctest::Approx( expect[j] ).epsilon(0.00001));
+            }
+        }
+    }
+
+    SUBCASE("Strided Column Major Output"){
+        // More Cameras Than One Block
+        const size_t count = 300;
+        const size_t stride = 20;
+        arcball arc;
+        arcball_batch batch;
+        for(size_t i=0;i<count;i++){
+            set_arc_vars_functor(arc, 0.01*i);
+            batch.Add(arc);
+            batch.QueueRotate(i, 0.3*i, -2.1);
+        }
+
+        std::vector<float> expect(16*count);
+        std::vector<float> updated(stride*count + 16), rows(stride*count + 16), columns(stride*count + 16);
+        arcball_batch copy = batch;
+        copy.Update(expect.data());
+        batch.Update(updated.data(), stride, row_major);
+
+        // 16 Byte Aligned so the Streamed Stores are Used
+        float *aligned = columns.data();
+        while((uintptr_t)aligned % 16 != 0){aligned++;}
+        batch.ViewProjMatrices(aligned, stride, column_major, true);
+        batch.ViewProjMatrices(rows.data() + 1, stride, row_major, true);
+
+        bool is_equal = true;
+        for(size_t i=0;i<count;i++){
+            for(int j=0;j<4;j++){
+                for(int k=0;k<4;k++){
+                    float value = expect[16*i + 4*j + k];
+                    is_equal = is_equal && updated[stride*i + 4*j + k] == value;
+                    is_equal = is_equal && rows[1 + stride*i + 4*j + k] == value;
+                    is_equal = is_equal && aligned[stride*i + 4*k + j] == value;
+                }
+            }
+        }
+        CHECK(is_equal);
+    }
+
+    SUBCASE("Get()"){
+        arcball arc;
+        set_arc_vars_functor(arc, 0);
+        arcball_batch batch;
+        batch.Add(arc);
+        batch.QueueTranslate(0, 2, 2);
+        batch.QueueTranslate(0, 2.4, 3.3);
+        batch.Update();
+
+        arcball output;
+        batch.Get(0, output);
+        arc.Translate(4.4, 5.3);
+
+        float expect[16];
+        float value[16];
+        arc.ViewProjMatrix(expect);
+        output.ViewProjMatrix(value);
+
+        for(int i=0;i<16;i++){
+            CHECK(value[i] == doctest::Approx( expect[i] ).epsilon(0.000001));
+        }
+    }
+}
+
+
+TEST_CASE("arcball_inertia"){
+
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    auto set_arc_vars = [&](arcball &arc){
+        arc.rotate_sensitivity = 0.01;
+        arc.zoom_sensitivity = 0.9;
+        arc.SetViewArea(1600, 900);
+        arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+        arc.SetCamera(camera_position, up_vec);
+    };
+
+    auto check_matrices = [](arcball &arc1, arcball &arc2, const float tolerance){
+        float expect[16];
+        float value[16];
+        arc1.ViewProjMatrix(expect);
+        arc2.ViewProjMatrix(value);
+        for(int i=0;i<16;i++){
+            CHECK(fabs(value[i] - expect[i]) <= tolerance*(1 + fabs(expect[i])));
+        }
+    };
+
+    SUBCASE("Closed Form Matches Stepping"){
+        // Each of Rotate, Translate, Zoom and Zoom to Cursor Alone Over 12 Whole Steps
+        float velocities[4][3] = {{300, 0, 0}, {-40, 90, 0}, {0, 0, 2}, {0, 0, -2}};
+        float mouse[2] = {100, 50};
+        for(int n=0;n<4;n++){
+            arcball arc, stepped;
+            set_arc_vars(arc);
+            set_arc_vars(stepped);
+            arcball_inertia inertia;
+            inertia.AddRotate(n == 0 ? velocities[n][0] : 0, 0);
+            inertia.AddTranslate(n == 1 ? velocities[n][0] : 0, velocities[n][1]);
+            inertia.AddZoom(n == 3 ? mouse[0] : 0, n == 3 ? mouse[1] : 0, velocities[n][2]);
+            inertia.Update(arc, 12.5f*inertia.time_step);
+
+            float velocity[3] = {velocities[n][0], velocities[n][1], velocities[n][2]};
+            float retention = exp(-inertia.damping*inertia.time_step);
+            for(int step=0;step<12;step++){
+                if(n == 0){stepped.Rotate(velocity[0]*inertia.time_step, 0);}
+                if(n == 1){stepped.Translate(velocity[0]*inertia.time_step, velocity[1]*inertia.time_step);}
+                if(n == 2){stepped.Zoom(0, 0, velocity[2]*inertia.time_step);}
+                if(n == 3){stepped.Zoom(mouse[0], mouse[1], velocity[2]*inertia.time_step);}
+                for(int i=0;i<3;i++){
+                    velocity[i] *= retention;
+                }
+            }
+            check_matrices(stepped, arc, 0.00001);
+            if(n == 0){CHECK(inertia.rotate_velocity[0] == doctest::Approx(velocity[0]).epsilon(0.00001));}
+            if(n == 1){CHECK(inertia.translate_velocity[1] == doctest::Approx(velocity[1]).epsilon(0.00001));}
+            if(n >= 2){CHECK(inertia.zoom_velocity == doctest::Approx(velocity[2]).epsilon(0.00001));}
+            for(int i=0;i<3;i++){
+                CHECK(arc.Center()[i] == doctest::Approx(stepped.Center()[i]).epsilon(0.00001));
+            }
+        }
+
+        // Diagonal Rotation Matches for quaternion_arcball
+        quaternion_arcball quat_arc, quat_stepped;
+        quat_arc.SetCamera(camera_position, up_vec);
+        quat_stepped.SetCamera(camera_position, up_vec);
+        arcball_inertia inertia;
+        inertia.AddRotate(300, -120);
+        inertia.Update(quat_arc, 12.5f*inertia.time_step);
+        float velocity[2] = {300, -120};
+        float retention = exp(-inertia.damping*inertia.time_step);
+        for(int step=0;step<12;step++){
+            quat_stepped.Rotate(velocity[0]*inertia.time_step, velocity[1]*inertia.time_step);
+            velocity[0] *= retention;
+            velocity[1] *= retention;
+        }
+        float expect[16];
+        float value[16];
+        quat_stepped.ViewProjMatrix(expect);
+        quat_arc.ViewProjMatrix(value);
+        for(int i=0;i<16;i++){
+            CHECK(fabs(value[i] - expect[i]) <= 0.00001*(1 + fabs(expect[i])));
+        }
+    }
+
+    SUBCASE("Partial Steps Carry Over"){
+        arcball arc;
+        set_arc_vars(arc);
+        arcball_inertia inertia;
+        inertia.AddRotate(300, 0);
+        unsigned version = arc.Version();
+
+        inertia.Update(arc, 0.6f*inertia.time_step);
+        CHECK(arc.Version() == version);
+        inertia.Update(arc, 0.6f*inertia.time_step);
+        CHECK(arc.Version() != version);
+    }
+
+    SUBCASE("Comes to Rest"){
+        arcball arc;
+        set_arc_vars(arc);
+        arcball_inertia inertia;
+        inertia.AddRotate(300, -120);
+        inertia.AddZoom(10, 20, -3);
+        inertia.Update(arc, 10);
+        CHECK_FALSE(inertia.IsMoving());
+
+        unsigned version = arc.Version();
+        inertia.Update(arc, 1);
+        CHECK(arc.Version() == version);
+
+        inertia.AddTranslate(50, 0);
+        CHECK(inertia.IsMoving());
+        inertia.Stop();
+        CHECK_FALSE(inertia.IsMoving());
+    }
+
+    SUBCASE("quaternion_arcball"){
+        quaternion_arcball quat_arc;
+        quat_arc.SetCamera(camera_position, up_vec);
+        arcball_inertia inertia;
+        inertia.AddRotate(200, 50);
+        unsigned version = quat_arc.Version();
+        inertia.Update<math_fast>(quat_arc, 0.1);
+        CHECK(quat_arc.Version() != version);
+    }
+
+    SUBCASE("arcball_inertia_batch"){
+        const size_t count = 9;
+        arcball arcs[count];
+        arcball_inertia inertias[count];
+        arcball_batch batch;
+        arcball_inertia_batch batch_inertia;
+        batch_inertia.Resize(count);
+        for(size_t i=0;i<count;i++){
+            set_arc_vars(arcs[i]);
+            batch.Add(arcs[i]);
+            float velocity = 40.0f*i - 150;
+            inertias[i].AddRotate(velocity, 0.5f*velocity);
+            batch_inertia.AddRotate(i, velocity, 0.5f*velocity);
+            inertias[i].AddTranslate(-velocity, 3);
+            batch_inertia.AddTranslate(i, -velocity, 3);
+            if(i % 3 == 0){
+                inertias[i].AddZoom(4, -2, 0.01f*velocity);
+                batch_inertia.AddZoom(i, 4, -2, 0.01f*velocity);
+            }
+        }
+
+        for(int frame=0;frame<5;frame++){
+            float elapsed = 0.013f + 0.002f*frame;
+            batch_inertia.Update(batch, elapsed);
+            batch.Update();
+            for(size_t i=0;i<count;i++){
+                inertias[i].Update(arcs[i], elapsed);
+            }
+        }
+        for(size_t i=0;i<count;i++){
+            arcball value;
+            batch.Get(i, value);
+            check_matrices(arcs[i], value, 0.0001);
+        }
+
+        arcball_batch wrong_size;
+        CHECK_THROWS(batch_inertia.Update(wrong_size, 0.1));
+    }
+
+    SUBCASE("Time Step Not Positive"){
+        arcball arc;
+        arcball_inertia inertia;
+        inertia.time_step = 0;
+        inertia.AddRotate(1, 1);
+        CHECK_THROWS(inertia.Update(arc, 0.1));
+    }
+}
+
+
 TEST_CASE("Quaternion"){
 
     SUBCASE("Operator *"){
@@ -678,3 +1521,1643 @@ TEST_CASE("Quaternion"){
 
 }
 
+
+
+TEST_CASE("quaternion_array"){
+
+    const int count = 11;
+    quaternion<float> q1[count];
+    quaternion<float> q2[count];
+    quaternion_array<float> array1(count);
+    quaternion_array<float> array2(count);
+
+    for(int i=0;i<count;i++){
+        q1[i] = quaternion<float>{-1.0f + i, 3, 4.0f - 0.7f*i, 3};
+        q2[i] = quaternion<float>{4, 3.9f - i, -1, -3.0f + 0.3f*i};
+        array1.Set(i, q1[i]);
+        array2.Set(i, q2[i]);
+    }
+
+    SUBCASE("Set() && Get()"){
+        quaternion<float> value = array1.Get(4);
+        for(int i=0;i<4;i++){
+            CHECK(value[i] == doctest::Approx( q1[4][i] ).epsilon(0.000001));
+            CHECK(array1.RawData(i)[4] == q1[4][i]);
+        }
+    }
+
+    SUBCASE("Multiply()"){
+        quaternion_array<float> output;
+        output.Multiply(array1, array2);
+        CHECK(output.Size() == (size_t)count);
+
+        for(int i=0;i<count;i++){
+            quaternion<float> expect = q1[i] * q2[i];
+            quaternion<float> value = output.Get(i);
+            for(int j=0;j<4;j++){
+                CHECK(value[j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+            }
+        }
+
+        output.Multiply(array1, q2[3]);
+        for(int i=0;i<count;i++){
+            quaternion<float> expect = q1[i] * q2[3];
+            quaternion<float> value = output.Get(i);
+            for(int j=0;j<4;j++){
+                CHECK(value[j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+            }
+        }
+    }
+
+    SUBCASE("Conj()"){
+        array1.Conj();
+        for(int i=0;i<count;i++){
+            quaternion<float> expect = q1[i];
+            expect.Conj();
+            quaternion<float> value = array1.Get(i);
+            for(int j=0;j<4;j++){
+                CHECK(value[j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+            }
+        }
+    }
+
+    SUBCASE("Rotate()"){
+        float x[count], y[count], z[count];
+        for(int i=0;i<count;i++){
+            x[i] = -1.2f + i;
+            y[i] = 0.37f;
+            z[i] = -5.8f + 0.5f*i;
+        }
+        array1.Rotate(x, y, z);
+
+        for(int i=0;i<count;i++){
+            float expect[3] = {-1.2f + i, 0.37f, -5.8f + 0.5f*i};
+            q1[i].Rotate(expect);
+            CHECK(x[i] == doctest::Approx( expect[0] ).epsilon(0.000001));
+            CHECK(y[i] == doctest::Approx( expect[1] ).epsilon(0.000001));
+            CHECK(z[i] == doctest::Approx( expect[2] ).epsilon(0.000001));
+        }
+    }
+
+    SUBCASE("RotationMatrix3() && RotationMatrix4()"){
+        float matrix3[count*9], matrix3t[count*9], matrix4[count*16], matrix4t[count*16];
+        array1.RotationMatrix3(matrix3);
+        array1.RotationMatrix3T(matrix3t);
+        array1.RotationMatrix4(matrix4);
+        array1.RotationMatrix4T(matrix4t);
+
+        for(int i=0;i<count;i++){
+            float expect3[9], expect3t[9], expect4[16], expect4t[16];
+            q1[i].RotationMatrix3(expect3);
+            q1[i].RotationMatrix3T(expect3t);
+            q1[i].RotationMatrix4(expect4);
+            q1[i].RotationMatrix4T(expect4t);
+            for(int j=0;j<9;j++){
+                CHECK(matrix3[i*9 + j] == doctest::Approx( expect3[j] ).epsilon(0.000001));
+                CHECK(matrix3t[i*9 + j] == doctest::Approx( expect3t[j] ).epsilon(0.000001));
+            }
+            for(int j=0;j<16;j++){
+                CHECK(matrix4[i*16 + j] == doctest::Approx( expect4[j] ).epsilon(0.000001));
+                CHECK(matrix4t[i*16 + j] == doctest::Approx( expect4t[j] ).epsilon(0.000001));
+            }
+        }
+    }
+
+    SUBCASE("nlerp()"){
+        quaternion_array<float> output;
+        output.nlerp(array1, array2, .156);
+
+        for(int i=0;i<count;i++){
+            quaternion<float> expect;
+            expect.nlerp(q1[i], q2[i], .156);
+            quaternion<float> value = output.Get(i);
+            for(int j=0;j<4;j++){
+                CHECK(value[j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+            }
+        }
+
+        bool is_error_thrown = false;
+        array2.Set(2, quaternion<float>{1, -3, -4.0f + 1.4f, -3});
+        array1.Set(2, quaternion<float>{-1, 3, 4.0f - 1.4f, 3});
+        try{
+            output.nlerp(array1, array2, .156);
+        }
+        catch(std::runtime_error e){
+            is_error_thrown = true;
+        }
+        CHECK(is_error_thrown == true);
+    }
+
+    // Only Exact When Both Sides Round the Same, Which an FMA Target may Not
+#ifndef __FMA__
+    SUBCASE("Same Bits as quaternion"){
+        quaternion_array<float> product;
+        quaternion_array<float> offset;
+        quaternion_array<float> blend;
+        product.Multiply(array1, array2);
+        offset.Multiply(array1, q2[3]);
+        blend.nlerp(array1, array2, .156);
+
+        for(int i=0;i<count;i++){
+            quaternion<float> expect_product = q1[i] * q2[i];
+            quaternion<float> expect_offset = q1[i] * q2[3];
+            quaternion<float> expect_blend;
+            expect_blend.nlerp(q1[i], q2[i], .156);
+            quaternion<float> value_product = product.Get(i);
+            quaternion<float> value_offset = offset.Get(i);
+            quaternion<float> value_blend = blend.Get(i);
+            CHECK(memcmp(value_product.RawData(), expect_product.RawData(), 4*sizeof(float)) == 0);
+            CHECK(memcmp(value_offset.RawData(), expect_offset.RawData(), 4*sizeof(float)) == 0);
+            CHECK(memcmp(value_blend.RawData(), expect_blend.RawData(), 4*sizeof(float)) == 0);
+        }
+    }
+#endif
+
+    SUBCASE("Output Aliasing an Input"){
+        // More Than One Stack Tile
+        const size_t size = 600;
+        quaternion_array<float> a(size), b(size);
+        for(size_t i=0;i<size;i++){
+            a.Set(i, q1[i % count]);
+            b.Set(i, q2[(i + 3) % count]);
+        }
+
+        quaternion_array<float> expect;
+        quaternion_array<float> value;
+        expect.Multiply(a, b);
+        value = a;
+        value.Multiply(value, b);
+        CHECK(value.Size() == size);
+        for(int j=0;j<4;j++){
+            CHECK(memcmp(value.RawData(j), expect.RawData(j), size*sizeof(float)) == 0);
+        }
+        value = b;
+        value.Multiply(a, value);
+        for(int j=0;j<4;j++){
+            CHECK(memcmp(value.RawData(j), expect.RawData(j), size*sizeof(float)) == 0);
+        }
+
+        expect.Multiply(a, q2[5]);
+        value = a;
+        value.Multiply(value, q2[5]);
+        for(int j=0;j<4;j++){
+            CHECK(memcmp(value.RawData(j), expect.RawData(j), size*sizeof(float)) == 0);
+        }
+
+        expect.nlerp(a, b, .4);
+        value = a;
+        value.nlerp(value, b, .4);
+        for(int j=0;j<4;j++){
+            CHECK(memcmp(value.RawData(j), expect.RawData(j), size*sizeof(float)) == 0);
+        }
+
+        quaternion_array<float> shorter(size - 1);
+        CHECK_THROWS(value.Multiply(a, shorter));
+    }
+
+    SUBCASE("Double Precision"){
+        quaternion<double> d1 = {-1, 3, 4, 3};
+        quaternion<double> d2 = {0.12, -3.159, -0.004, 2.15};
+        quaternion_array<double> a1(2), a2(2), output;
+        a1.Set(1, d1);
+        a2.Set(1, d2);
+        output.Multiply(a1, a2);
+
+        quaternion<double> expect = d1 * d2;
+        quaternion<double> value = output.Get(1);
+        for(int j=0;j<4;j++){
+            CHECK(value[j] == doctest::Approx( expect[j] ).epsilon(0.000001));
+        }
+    }
+
+    SUBCASE("SetWithEuler() && Euler()"){
+        // Enough Samples for Several Parallel Chunks, Including the Poles
+        const size_t sample_count = 50000;
+        std::vector<float> roll(sample_count), pitch(sample_count), yaw(sample_count);
+        for(size_t i=0;i<sample_count;i++){
+            roll[i] = -3.1f + 0.000123f*i;
+            pitch[i] = i % 97 == 0 ? 1.57079632679f*(i % 2 ? 1 : -1) : -1.55f + 0.0000617f*i;
+            yaw[i] = 2.9f - 0.000119f*i;
+        }
+        thread_pool pool(3);
+        quaternion_array<float> output;
+        output.SetWithEuler(roll.data(), pitch.data(), yaw.data(), sample_count, pool);
+        REQUIRE(output.Size() == sample_count);
+
+        std::vector<float> angles(3*sample_count);
+        output.Euler(&angles[0], &angles[sample_count], &angles[2*sample_count], pool);
+
+        for(size_t i=0;i<sample_count;i+=7){
+            quaternion<float> expect;
+            expect.SetWithEuler(roll[i], pitch[i], yaw[i]);
+            quaternion<float> value = output.Get(i);
+            for(int j=0;j<4;j++){
+                CHECK(fabs(value[j] - expect[j]) <= 0.0000003);
+            }
+
+            float expect_angles[3];
+            value.Euler(expect_angles);
+            for(int j=0;j<3;j++){
+                CHECK(fabs(angles[j*sample_count + i] - expect_angles[j]) <= 0.000001);
+            }
+        }
+
+        // Pole Samples Take the Pole Branch
+        for(size_t i=0;i<sample_count;i+=97){
+            float expect_angles[3];
+            output.Get(i).Euler(expect_angles);
+            CHECK(angles[sample_count + i] == expect_angles[1]);
+            CHECK(angles[2*sample_count + i] == 0);
+        }
+    }
+
+    SUBCASE("Double Precision Euler"){
+        float roll[3] = {0.3, -2.8, 1.1};
+        float pitch[3] = {-0.7, 0.2, 1.5};
+        float yaw[3] = {2.1, 0.05, -3.0};
+        quaternion_array<double> output;
+        output.SetWithEuler(roll, pitch, yaw, 3);
+        float angles[9];
+        output.Euler(angles, angles + 3, angles + 6);
+        for(int i=0;i<3;i++){
+            quaternion<double> expect;
+            expect.SetWithEuler(roll[i], pitch[i], yaw[i]);
+            for(int j=0;j<4;j++){
+                CHECK(fabs(output.RawData(j)[i] - expect[j]) <= 0.0000003);
+            }
+            CHECK(angles[i] == doctest::Approx(roll[i]).epsilon(0.000001));
+            CHECK(angles[3 + i] == doctest::Approx(pitch[i]).epsilon(0.000001));
+            CHECK(angles[6 + i] == doctest::Approx(yaw[i]).epsilon(0.000001));
+        }
+    }
+
+    SUBCASE("Strided Output"){
+        const size_t stride = 24;
+        std::vector<float> matrix4(16*count), matrix4t(16*count);
+        array1.RotationMatrix4(matrix4.data());
+        array1.RotationMatrix4T(matrix4t.data());
+
+        std::vector<float> rows(stride*count + 4), columns(stride*count + 4);
+        float *aligned = columns.data();
+        while((uintptr_t)aligned % 16 != 0){aligned++;}
+        array1.RotationMatrix4(rows.data() + 1, stride, row_major);
+        array1.RotationMatrix4(aligned, stride, column_major, true);
+        for(int i=0;i<count;i++){
+            for(int j=0;j<16;j++){
+                CHECK(rows[1 + stride*i + j] == matrix4[16*i + j]);
+                CHECK(aligned[stride*i + j] == matrix4t[16*i + j]);
+            }
+        }
+
+        float single[16], expect[16];
+        q1[0].RotationMatrix4T(expect);
+        q1[0].RotationMatrix4(single, column_major);
+        for(int j=0;j<16;j++){
+            CHECK(single[j] == expect[j]);
+        }
+    }
+
+    SUBCASE("Thread Pool"){
+        // Several 1024 Quaternion Chunks so the Pool Actually Splits the Work
+        const size_t large_count = 2563;
+        quaternion_array<float> quats(large_count);
+        for(size_t i=0;i<large_count;i++){
+            quats.Set(i, quaternion<float>{0.3f + 0.001f*i, -1.2f, 0.7f - 0.0005f*i, 2.1f});
+        }
+        thread_pool pool(3);
+
+        std::vector<float> expect(16*large_count), value(16*large_count);
+        quats.RotationMatrix4(expect.data());
+        quats.RotationMatrix4(value.data(), pool);
+        CHECK(value == expect);
+        quats.RotationMatrix4T(expect.data());
+        quats.RotationMatrix4T(value.data(), pool);
+        CHECK(value == expect);
+
+        std::vector<float> expect_xyz(3*large_count), value_xyz(3*large_count);
+        for(size_t i=0;i<expect_xyz.size();i++){
+            expect_xyz[i] = value_xyz[i] = 0.01f*(i % 101) - 0.4f;
+        }
+        quats.Rotate(&expect_xyz[0], &expect_xyz[large_count], &expect_xyz[2*large_count]);
+        quats.Rotate(&value_xyz[0], &value_xyz[large_count], &value_xyz[2*large_count], pool);
+        CHECK(value_xyz == expect_xyz);
+    }
+}
+
+
+TEST_CASE("RotatePoints()"){
+
+    const size_t count = 3*point_chunk_size + 77;
+    quaternion<float> quat1 = {-1, 3, 4, 3};
+    thread_pool pool(3);
+
+    std::vector<float> points(3*count);
+    for(size_t i=0;i<points.size();i++){
+        points[i] = 0.01*(i % 1013) - 5.8;
+    }
+    std::vector<float> expect(points);
+    for(size_t i=0;i<count;i++){
+        quat1.Rotate(&expect[3*i]);
+    }
+
+    SUBCASE("Interleaved"){
+        std::vector<float> output(3*count);
+        RotatePoints(quat1, points.data(), output.data(), count, pool);
+
+        bool is_equal = true;
+        for(size_t i=0;i<output.size();i++){
+            is_equal = is_equal && output[i] == doctest::Approx( expect[i] ).epsilon(0.000001);
+        }
+        CHECK(is_equal);
+    }
+
+    SUBCASE("Interleaved In Place"){
+        RotatePoints(quat1, points.data(), points.data(), count, pool);
+
+        bool is_equal = true;
+        for(size_t i=0;i<points.size();i++){
+            is_equal = is_equal && points[i] == doctest::Approx( expect[i] ).epsilon(0.000001);
+        }
+        CHECK(is_equal);
+    }
+
+    SUBCASE("Separate Arrays"){
+        std::vector<float> x(count), y(count), z(count);
+        for(size_t i=0;i<count;i++){
+            x[i] = points[3*i];
+            y[i] = points[3*i + 1];
+            z[i] = points[3*i + 2];
+        }
+        RotatePoints(quat1, x.data(), y.data(), z.data(), count, pool);
+
+        bool is_equal = true;
+        for(size_t i=0;i<count;i++){
+            is_equal = is_equal && x[i] == doctest::Approx( expect[3*i] ).epsilon(0.000001);
+            is_equal = is_equal && y[i] == doctest::Approx( expect[3*i + 1] ).epsilon(0.000001);
+            is_equal = is_equal && z[i] == doctest::Approx( expect[3*i + 2] ).epsilon(0.000001);
+        }
+        CHECK(is_equal);
+
+        // Out of Place Gives the Same Bits and Leaves the Inputs Alone
+        std::vector<float> in_x(count), in_y(count), in_z(count);
+        std::vector<float> out_x(count), out_y(count), out_z(count);
+        for(size_t i=0;i<count;i++){
+            in_x[i] = points[3*i];
+            in_y[i] = points[3*i + 1];
+            in_z[i] = points[3*i + 2];
+        }
+        RotatePoints(quat1, in_x.data(), in_y.data(), in_z.data(), out_x.data(), out_y.data(), out_z.data(), count,
+            pool);
+        CHECK(out_x == x);
+        CHECK(out_y == y);
+        CHECK(out_z == z);
+        bool is_unchanged = true;
+        for(size_t i=0;i<count;i++){
+            is_unchanged = is_unchanged && in_x[i] == points[3*i] && in_y[i] == points[3*i + 1] &&
+                in_z[i] == points[3*i + 2];
+        }
+        CHECK(is_unchanged);
+    }
+}
+
+
+TEST_CASE("UnprojectPoints()"){
+
+    // Enough Points for Several Parallel Chunks
+    const size_t count = 3*point_chunk_size + 41;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    arcball arc;
+    arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+
+    float viewproj[16];
+    float inverse[16];
+    arc.ViewProjMatrix(viewproj);
+    arc.InverseViewProjMatrix(inverse);
+
+    // World Points Around the Center, Projected to NDC
+    std::vector<float> world(3*count), ndc(3*count), output(3*count);
+    for(size_t i=0;i<count;i++){
+        float point[4] = {center_position[0] + 0.0007f*(i % 1009) - 0.35f,
+            center_position[1] + 0.0005f*(i % 997) - 0.25f, center_position[2] + 0.00001f*i - 0.6f, 1};
+        float clip[4] = {0, 0, 0, 0};
+        for(int j=0;j<4;j++){
+            for(int k=0;k<4;k++){
+                clip[j] += viewproj[4*j + k]*point[k];
+            }
+        }
+        for(int j=0;j<3;j++){
+            world[j*count + i] = point[j];
+            ndc[j*count + i] = clip[j]/clip[3];
+        }
+    }
+
+    thread_pool pool(3);
+    UnprojectPoints(inverse, &ndc[0], &ndc[count], &ndc[2*count], &output[0], &output[count], &output[2*count],
+        count, pool);
+
+    bool is_close = true;
+    for(size_t i=0;i<3*count;i++){
+        is_close = is_close && fabs(output[i] - world[i]) <= 0.0005;
+    }
+    CHECK(is_close);
+
+    // Near and Far Plane Corners Land on the Frustum
+    float corner_x[2] = {-1, 1};
+    float corner_y[2] = {1, -1};
+    float corner_z[2] = {-1, 1};
+    float out_x[2], out_y[2], out_z[2];
+    UnprojectPointsSerial(inverse, corner_x, corner_y, corner_z, out_x, out_y, out_z, 2);
+    float planes[24];
+    arc.FrustumPlanes(planes);
+    for(int i=0;i<2;i++){
+        float point[3] = {out_x[i], out_y[i], out_z[i]};
+        for(int j=0;j<6;j++){
+            CHECK(DotVec<3>(planes + 4*j, point) + planes[4*j + 3] >= -0.001);
+        }
+    }
+}
+
+
+TEST_CASE("arcball_event_queue"){
+
+    auto set_arc_vars_functor = [&](arcball &arc){
+        float camera_position[3] = {1.41, 2.05, 4.39};
+        float up_vec[3] = {0, 0, 1};
+        float center_position[3] = {0.3, 1.5, 0.083};
+        arc.rotate_sensitivity = 0.01;
+        arc.zoom_sensitivity = 0.2;
+        arc.SetViewArea(1600, 900);
+        arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+        arc.SetCamera(camera_position, up_vec);
+        arc.SetCenter(center_position);
+    };
+
+    arcball expect_arc;
+    arcball value_arc;
+    set_arc_vars_functor(expect_arc);
+    set_arc_vars_functor(value_arc);
+    arcball_event_queue queue(64);
+    float tolerance = 0.00001;
+
+    SUBCASE("Rotate Run"){
+        float deltas[5][2] = {{1, 2}, {2, 1}, {0, 0}, {-1.5, 3}, {2, -2}};
+        for(int i=0;i<5;i++){
+            CHECK(queue.PushRotate(deltas[i][0], deltas[i][1]));
+            expect_arc.Rotate(deltas[i][0], deltas[i][1]);
+        }
+        CHECK(queue.Drain(value_arc) == 5);
+
+        // Composed Rotations are Rigid, Sequential Rotates Drift Slightly
+        tolerance = 0.002;
+    }
+
+    SUBCASE("Translate Run"){
+        for(int i=0;i<6;i++){
+            queue.PushTranslate(0.5*i, 3 - i);
+            expect_arc.Translate(0.5*i, 3 - i);
+        }
+        CHECK(queue.Drain(value_arc) == 6);
+    }
+
+    SUBCASE("Zoom Run"){
+        float zooms[6] = {-1, -2, 0.5, -3, 1, -0.25};
+        for(int i=0;i<6;i++){
+            queue.PushZoom(44, -53, zooms[i]);
+            expect_arc.Zoom(44, -53, zooms[i]);
+        }
+        CHECK(queue.Drain(value_arc) == 6);
+    }
+
+    SUBCASE("Mixed Events"){
+        queue.PushRotate(3, 4);
+        queue.PushRotate(-1, 2);
+        queue.PushTranslate(4.4, 5.3);
+        queue.PushZoom(10, 20, -1);
+        queue.PushZoom(-10, 20, -1);
+        queue.PushRotate(2, 2);
+        expect_arc.Rotate(3, 4);
+        expect_arc.Rotate(-1, 2);
+        expect_arc.Translate(4.4, 5.3);
+        expect_arc.Zoom(10, 20, -1);
+        expect_arc.Zoom(-10, 20, -1);
+        expect_arc.Rotate(2, 2);
+        CHECK(queue.Drain(value_arc) == 6);
+        CHECK(queue.Drain(value_arc) == 0);
+        tolerance = 0.002;
+    }
+
+    SUBCASE("Full Queue"){
+        for(int i=0;i<64;i++){
+            CHECK(queue.PushTranslate(1, 1));
+        }
+        CHECK(queue.PushTranslate(1, 1) == false);
+        CHECK(queue.Drain(value_arc) == 64);
+        CHECK(queue.PushTranslate(1, 1));
+        queue.Drain(value_arc);
+        for(int i=0;i<65;i++){
+            expect_arc.Translate(1, 1);
+        }
+    }
+
+    SUBCASE("Producer Thread"){
+        std::thread producer([&]{
+            for(int i=0;i<1000;i++){
+                while(!queue.PushTranslate(0.01, -0.02)){std::this_thread::yield();}
+            }
+        });
+        size_t drained = 0;
+        while(drained < 1000){
+            drained += queue.Drain(value_arc);
+        }
+        producer.join();
+        expect_arc.Translate(10, -20);
+        tolerance = 0.0001;
+    }
+
+    float expect[16];
+    float value[16];
+    expect_arc.ViewProjMatrix(expect);
+    value_arc.ViewProjMatrix(value);
+
+    for(int i=0;i<16;i++){
+        CHECK(fabs(value[i] - expect[i]) < tolerance*(1 + fabs(expect[i])));
+    }
+}
+
+
+TEST_CASE("arcball_publisher"){
+
+    arcball arc;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    arc.SetViewArea(1600, 900);
+    arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+
+    arcball_publisher publisher;
+    arcball_snapshot snapshot;
+
+    SUBCASE("Publish() && Read()"){
+        CHECK(publisher.Read(snapshot) == false);
+
+        publisher.Publish(arc);
+        CHECK(publisher.Count() == 1);
+        REQUIRE(publisher.Read(snapshot));
+
+        float expect[16];
+        arc.ViewProjMatrix(expect);
+        for(int i=0;i<3;i++){
+            CHECK(snapshot.camera_pos[i] == arc.Camera()[i]);
+            CHECK(snapshot.center_pos[i] == arc.Center()[i]);
+        }
+        for(int i=0;i<9;i++){
+            CHECK(snapshot.basis[i] == arc.Basis()[i]);
+        }
+        for(int i=0;i<16;i++){
+            CHECK(snapshot.view_proj[i] == expect[i]);
+        }
+        CHECK(snapshot.version == arc.Version());
+
+        // Unchanged Camera Isn't Republished
+        publisher.Publish(arc);
+        CHECK(publisher.Count() == 1);
+        arc.Rotate(4.4, 5.3);
+        publisher.Publish(arc);
+        CHECK(publisher.Count() == 2);
+        publisher.Read(snapshot);
+        CHECK(snapshot.version == arc.Version());
+    }
+
+    SUBCASE("Concurrent Readers See Whole Snapshots"){
+        publisher.Publish(arc);
+        std::atomic<bool> is_running(true);
+        std::atomic<int> torn_count(0);
+
+        auto reader = [&]{
+            arcball_snapshot local;
+            while(is_running.load()){
+                publisher.Read(local);
+
+                // Back Vector Must Come From the Same Camera Position
+                float back[3];
+                DiffVec<3>(local.camera_pos, local.center_pos, back);
+                NormalizeVec<3>(back);
+                for(int i=0;i<3;i++){
+                    if(fabs(back[i] - local.basis[6 + i]) > 0.0001){torn_count++;}
+                }
+            }
+        };
+        std::thread reader1(reader);
+        std::thread reader2(reader);
+
+        for(int i=0;i<2000;i++){
+            arc.Rotate(4.4, 5.3);
+            publisher.Publish(arc);
+        }
+        is_running = false;
+        reader1.join();
+        reader2.join();
+
+        CHECK(torn_count.load() == 0);
+        CHECK(publisher.Count() == 2001);
+    }
+}
+
+
+TEST_CASE("arcball::MouseRays()"){
+
+    arcball arc;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    arc.SetViewArea(1600, 900);
+    arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+
+    const size_t width = 37;
+    const size_t height = 1000;
+    const size_t row_stride = 40;
+    const float mouse_x = 800;
+    const float mouse_y = 450;
+    thread_pool pool(3);
+
+    auto check_ray = [&](size_t row, size_t column, float x, float y, float z){
+        float expect[3];
+        arc.MouseRay(mouse_x - column, mouse_y - row, expect);
+        CHECK(x == doctest::Approx( expect[0] ).epsilon(0.00001));
+        CHECK(y == doctest::Approx( expect[1] ).epsilon(0.00001));
+        CHECK(z == doctest::Approx( expect[2] ).epsilon(0.00001));
+    };
+
+    SUBCASE("Separate Arrays"){
+        std::vector<float> dir_x(height*row_stride, 7);
+        std::vector<float> dir_y(height*row_stride, 7);
+        std::vector<float> dir_z(height*row_stride, 7);
+        arc.MouseRays(mouse_x, mouse_y, width, height, dir_x.data(), dir_y.data(), dir_z.data(), row_stride, pool);
+
+        for(size_t row=0;row<height;row+=37){
+            for(size_t column=0;column<width;column++){
+                size_t i = row*row_stride + column;
+                check_ray(row, column, dir_x[i], dir_y[i], dir_z[i]);
+            }
+            // Padding Between Rows is Untouched
+            CHECK(dir_x[row*row_stride + width] == 7);
+        }
+    }
+
+    SUBCASE("Packets"){
+        const size_t packet_width = 8;
+        const size_t packet_count = 5;
+        std::vector<float> packets(height*packet_count*3*packet_width);
+        arc.MouseRayPackets(mouse_x, mouse_y, width, height, packets.data(), packet_width, pool);
+
+        for(size_t row=0;row<height;row+=37){
+            for(size_t column=0;column<width;column++){
+                const float *packet = &packets[(row*packet_count + column/packet_width)*3*packet_width];
+                size_t lane = column % packet_width;
+                check_ray(row, column, packet[lane], packet[packet_width + lane], packet[2*packet_width + lane]);
+            }
+        }
+    }
+
+    SUBCASE("Empty Tile"){
+        float value = 7;
+        arc.MouseRays(mouse_x, mouse_y, 0, height, &value, &value, &value, row_stride, pool);
+        arc.MouseRayPackets(mouse_x, mouse_y, 0, height, &value, 8, pool);
+        CHECK(value == 7);
+    }
+}
+
+
+TEST_CASE("arcball::DepthPoints()"){
+
+    arcball arc;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    arc.SetViewArea(1600, 900);
+    arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+    arc.SetCamera(camera_position, up_vec);
+
+    // Wider Than a Block and Enough Rows for Several Tiles
+    const size_t width = 300;
+    const size_t height = 90;
+    const size_t row_stride = 310;
+    const float mouse_x = 150;
+    const float mouse_y = 45;
+    std::vector<float> depth(height*row_stride, 0.5f);
+    size_t drawn_count = 0;
+    for(size_t row=0;row<height;row++){
+        for(size_t column=0;column<width;column++){
+            float value = (row*width + column) % 7 == 0 ? 1 : 0.2f + 0.79f*((row*31 + column*17) % 101)/100;
+            depth[row*row_stride + column] = value;
+            drawn_count += value < 1;
+        }
+    }
+
+    struct collect_sink{
+        std::mutex mutex;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<uint32_t> pixels;
+        size_t largest_tile;
+        void operator()(const float *tile_x, const float *tile_y, const float *tile_z, const uint32_t *tile_pixels,
+        const size_t count){
+            std::lock_guard<std::mutex> lock(mutex);
+            x.insert(x.end(), tile_x, tile_x + count);
+            y.insert(y.end(), tile_y, tile_y + count);
+            z.insert(z.end(), tile_z, tile_z + count);
+            pixels.insert(pixels.end(), tile_pixels, tile_pixels + count);
+            largest_tile = std::max(largest_tile, count);
+        }
+    } sink;
+    sink.largest_tile = 0;
+    thread_pool pool(3);
+    arc.DepthPoints(mouse_x, mouse_y, width, height, depth.data(), row_stride, sink, pool);
+
+    REQUIRE(sink.pixels.size() == drawn_count);
+    CHECK(sink.largest_tile <= depth_tile_size);
+
+    float viewproj[16];
+    arc.ViewProjMatrix(viewproj);
+    std::vector<int> seen(width*height, 0);
+    bool is_on_ray = true;
+    bool is_at_depth = true;
+    for(size_t i=0;i<sink.pixels.size();i++){
+        size_t row = sink.pixels[i]/width;
+        size_t column = sink.pixels[i] % width;
+        seen[sink.pixels[i]]++;
+
+        float point[4] = {sink.x[i], sink.y[i], sink.z[i], 1};
+        float ray[3];
+        float offset[3];
+        float cross[3];
+        arc.MouseRay(mouse_x - column, mouse_y - row, ray);
+        DiffVec<3>(point, camera_position, offset);
+        CrossVec(offset, ray, cross);
+        is_on_ray = is_on_ray && MagnitudeVec<3>(cross) <= 0.0001*MagnitudeVec<3>(offset)*MagnitudeVec<3>(ray);
+
+        float clip[4] = {0, 0, 0, 0};
+        for(int j=0;j<4;j++){
+            for(int k=0;k<4;k++){
+                clip[j] += viewproj[4*j + k]*point[k];
+            }
+        }
+        float window_depth = 0.5f*(clip[2]/clip[3] + 1);
+        is_at_depth = is_at_depth && fabs(window_depth - depth[row*row_stride + column]) <= 0.0001;
+    }
+    CHECK(is_on_ray);
+    CHECK(is_at_depth);
+
+    bool is_once = true;
+    for(size_t i=0;i<width*height;i++){
+        is_once = is_once && seen[i] == (depth[(i/width)*row_stride + i % width] < 1 ? 1 : 0);
+    }
+    CHECK(is_once);
+
+    // Empty Images Call Nothing, Images Past 32 Bit Pixel Indices Throw
+    // Before Reading Any Depth
+    sink.pixels.clear();
+    arc.DepthPoints(mouse_x, mouse_y, 0, height, depth.data(), row_stride, sink, pool);
+    arc.DepthPoints(mouse_x, mouse_y, width, 0, depth.data(), row_stride, sink, pool);
+    CHECK(sink.pixels.empty());
+    if(sizeof(size_t) > 4){
+        CHECK_THROWS(arc.DepthPoints(mouse_x, mouse_y, (size_t)1 << 17, (size_t)1 << 16, depth.data(), row_stride,
+            sink, pool));
+    }
+}
+
+
+TEST_CASE("bvh"){
+
+    // Deterministic Pseudo Random Triangles in a 10 x 10 x 10 Box
+    unsigned seed = 12345;
+    auto random = [&](){
+        seed = seed*1664525 + 1013904223;
+        return (seed >> 8)*(1.0f/16777216);
+    };
+    const size_t count = 3000;
+    std::vector<float> triangles(9*count);
+    for(size_t i=0;i<count;i++){
+        float center[3] = {10*random() - 5, 10*random() - 5, 10*random() - 5};
+        for(int j=0;j<9;j++){
+            triangles[9*i + j] = center[j % 3] + 0.6f*random() - 0.3f;
+        }
+    }
+
+    auto brute_force = [&](const float *origin, const float *direction, const std::vector<float> &data, bvh_hit &hit){
+        bool is_hit = false;
+        float closest = std::numeric_limits<float>::infinity();
+        for(size_t i=0;i<count;i++){
+            const float *v = &data[9*i];
+            float e1[3], e2[3], s[3], p[3], q[3];
+            DiffVec<3>(v + 3, v, e1);
+            DiffVec<3>(v + 6, v, e2);
+            DiffVec<3>(origin, v, s);
+            CrossVec(direction, e2, p);
+            float det = DotVec<3>(e1, p);
+            if(det == 0){continue;}
+            float u = DotVec<3>(s, p)/det;
+            CrossVec(s, e1, q);
+            float v2 = DotVec<3>(direction, q)/det;
+            float t = DotVec<3>(e2, q)/det;
+            if(u < 0 || u > 1 || v2 < 0 || u + v2 > 1 || t <= 0 || t >= closest){continue;}
+            closest = t;
+            hit.primitive = i;
+            hit.distance = t;
+            is_hit = true;
+        }
+        return is_hit;
+    };
+
+    auto check_rays = [&](const bvh &tree, const std::vector<float> &data){
+        int hit_count = 0;
+        for(int i=0;i<300;i++){
+            float origin[3] = {20*random() - 10, 20*random() - 10, 20*random() - 10};
+            float target[3] = {8*random() - 4, 8*random() - 4, 8*random() - 4};
+            float direction[3];
+            DiffVec<3>(target, origin, direction);
+
+            bvh_hit expect;
+            bvh_hit value;
+            bool is_expect = brute_force(origin, direction, data, expect);
+            REQUIRE(tree.Intersect(origin, direction, value) == is_expect);
+            if(is_expect){
+                CHECK(value.distance == doctest::Approx( expect.distance ).epsilon(0.0001));
+                hit_count++;
+            }
+        }
+        CHECK(hit_count > 100);
+    };
+
+    bvh tree;
+    thread_pool pool(3);
+
+    SUBCASE("BuildTriangles() && Intersect()"){
+        tree.BuildTriangles(triangles.data(), count, pool);
+        CHECK(tree.Size() == count);
+
+        // Every Node Contains its Children
+        const bvh_node *nodes = tree.Nodes();
+        for(size_t i=0;i<tree.NodeCount();i++){
+            if(nodes[i].count > 0){continue;}
+            for(int child=0;child<2;child++){
+                for(int j=0;j<3;j++){
+                    CHECK(nodes[nodes[i].first + child].min[j] >= nodes[i].min[j]);
+                    CHECK(nodes[nodes[i].first + child].max[j] <= nodes[i].max[j]);
+                }
+            }
+        }
+        check_rays(tree, triangles);
+    }
+
+    SUBCASE("Refit()"){
+        tree.BuildTriangles(triangles.data(), count, pool);
+
+        // Move a Few Triangles and Refit Only Their Paths
+        std::vector<size_t> changed;
+        for(size_t i=0;i<count;i+=97){
+            for(int j=0;j<9;j++){
+                triangles[9*i + j] += (j % 3 == 0) ? 1.5f : -0.7f;
+            }
+            changed.push_back(i);
+        }
+        tree.Refit(changed.data(), changed.size());
+        check_rays(tree, triangles);
+
+        // Move Everything and Refit the Whole Tree
+        for(size_t i=0;i<triangles.size();i++){
+            triangles[i] *= 0.8f;
+        }
+        tree.Refit();
+        check_rays(tree, triangles);
+
+        CHECK_THROWS(tree.Refit(&count, 1));
+    }
+
+    SUBCASE("BuildBoxes()"){
+        float boxes[12] = {0, 0, 0, 1, 1, 1,  0, 0, 3, 1, 1, 4};
+        tree.BuildBoxes(boxes, 2, pool);
+        float origin[3] = {0.5, 0.5, 10};
+        float direction[3] = {0, 0, -2};
+        bvh_hit hit;
+        REQUIRE(tree.Intersect(origin, direction, hit));
+        CHECK(hit.primitive == 1);
+        CHECK(hit.distance == doctest::Approx(3));
+
+        float miss[3] = {0, 1, 0};
+        CHECK(tree.Intersect(origin, miss, hit) == false);
+    }
+
+    SUBCASE("Pick()"){
+        tree.BuildTriangles(triangles.data(), count, pool);
+        arcball arc;
+        float camera_position[3] = {14.1, 20.5, 4.39};
+        float up_vec[3] = {0, 0, 1};
+        float center_position[3] = {0.3, 1.5, 0.083};
+        arc.SetViewArea(1600, 900);
+        arc.SetCamera(camera_position, up_vec);
+        arc.SetCenter(center_position);
+
+        int hit_count = 0;
+        for(int i=0;i<50;i++){
+            float mouse_x = 400*random() - 200;
+            float mouse_y = 400*random() - 200;
+            float direction[3];
+            arc.MouseRay(mouse_x, mouse_y, direction);
+            bvh_hit expect;
+            bvh_hit value;
+            bool is_expect = brute_force(arc.Camera(), direction, triangles, expect);
+            REQUIRE(tree.Pick(arc, mouse_x, mouse_y, value) == is_expect);
+            if(is_expect){
+                CHECK(value.primitive == expect.primitive);
+                hit_count++;
+            }
+        }
+        CHECK(hit_count > 10);
+    }
+
+    SUBCASE("Empty"){
+        tree.BuildTriangles(triangles.data(), 0, pool);
+        float origin[3] = {0, 0, 10};
+        float direction[3] = {0, 0, -1};
+        bvh_hit hit;
+        CHECK(tree.Intersect(origin, direction, hit) == false);
+    }
+}
+
+
+TEST_CASE("FrustumPlanes() && Culling"){
+
+    arcball arc;
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    arc.SetViewArea(1600, 900);
+    arc.SetProjectionVars(40*3.14/180, 0.1, 10.95);
+    arc.SetCamera(camera_position, up_vec);
+    arc.SetCenter(center_position);
+
+    float planes[24];
+    arc.FrustumPlanes(planes);
+
+    SUBCASE("Matches ViewProjMatrix()"){
+        // Rows of the Matrix Added to and Subtracted From the w Row
+        float viewproj[16];
+        arc.ViewProjMatrix(viewproj);
+        for(int i=0;i<6;i++){
+            float sign = (i % 2 == 0) ? 1 : -1;
+            float expect[4];
+            for(int j=0;j<4;j++){
+                expect[j] = viewproj[12 + j] + sign*viewproj[4*(i/2) + j];
+            }
+            float length = sqrt(DotVec<3>(expect, expect));
+            for(int j=0;j<4;j++){
+                CHECK(planes[4*i + j] == doctest::Approx( expect[j]/length ).epsilon(0.0001));
+            }
+        }
+    }
+
+    unsigned seed = 777;
+    auto random = [&](){
+        seed = seed*1664525 + 1013904223;
+        return (seed >> 8)*(1.0f/16777216);
+    };
+    const size_t count = 200000;
+    std::vector<float> x(count), y(count), z(count), size(count);
+    for(size_t i=0;i<count;i++){
+        x[i] = 24*random() - 12;
+        y[i] = 24*random() - 12;
+        z[i] = 24*random() - 12;
+        size[i] = 0.5f*random();
+    }
+    std::vector<uint32_t> visible(count);
+    thread_pool pool(3);
+
+    SUBCASE("CullSpheres()"){
+        std::vector<uint32_t> expect;
+        for(size_t i=0;i<count;i++){
+            bool is_inside = true;
+            for(int j=0;j<6;j++){
+                const float *p = planes + 4*j;
+                is_inside = is_inside && p[0]*x[i] + p[1]*y[i] + p[2]*z[i] + p[3] >= -size[i];
+            }
+            if(is_inside){expect.push_back(i);}
+        }
+        REQUIRE(expect.size() > 1000);
+        REQUIRE(expect.size() < count/2);
+
+        size_t visible_count = CullSpheres(planes, x.data(), y.data(), z.data(), size.data(), count, visible.data(), pool);
+        REQUIRE(visible_count == expect.size());
+        for(size_t i=0;i<visible_count;i++){
+            CHECK(visible[i] == expect[i]);
+        }
+    }
+
+    SUBCASE("CullBoxes()"){
+        std::vector<float> max_x(count), max_y(count), max_z(count);
+        std::vector<uint32_t> expect;
+        for(size_t i=0;i<count;i++){
+            max_x[i] = x[i] + size[i];
+            max_y[i] = y[i] + 2*size[i];
+            max_z[i] = z[i] + 0.5f*size[i];
+
+            // Outside When All 8 Corners are Behind One Plane
+            bool is_inside = true;
+            for(int j=0;j<6;j++){
+                const float *p = planes + 4*j;
+                bool is_behind = true;
+                for(int corner=0;corner<8;corner++){
+                    float cx = (corner & 1) ? max_x[i] : x[i];
+                    float cy = (corner & 2) ? max_y[i] : y[i];
+                    float cz = (corner & 4) ? max_z[i] : z[i];
+                    is_behind = is_behind && p[0]*cx + p[1]*cy + p[2]*cz + p[3] < 0;
+                }
+                is_inside = is_inside && !is_behind;
+            }
+            if(is_inside){expect.push_back(i);}
+        }
+        REQUIRE(expect.size() > 1000);
+
+        size_t visible_count = CullBoxes(planes, x.data(), y.data(), z.data(),
+            max_x.data(), max_y.data(), max_z.data(), count, visible.data(), pool);
+        REQUIRE(visible_count == expect.size());
+        for(size_t i=0;i<visible_count;i++){
+            CHECK(visible[i] == expect[i]);
+        }
+
+        // Serial Kernel on a Sub Range
+        visible_count = CullBoxesSerial(planes, x.data(), y.data(), z.data(),
+            max_x.data(), max_y.data(), max_z.data(), 1000, 1300, visible.data());
+        size_t expect_count = std::lower_bound(expect.begin(), expect.end(), 1300u) - std::lower_bound(expect.begin(), expect.end(), 1000u);
+        CHECK(visible_count == expect_count);
+    }
+}
+
+
+TEST_CASE("quaternion_tracks"){
+
+    // Reference slerp in Double Precision Along the Short Path
+    auto reference_slerp = [](const quaternion<float> &q1, const quaternion<float> &q2, double t, double *out){
+        const float *a = q1.RawData();
+        const float *b = q2.RawData();
+        double dot = 0;
+        for(int i=0;i<4;i++){dot += (double)a[i]*b[i];}
+        double sign = dot < 0 ? -1 : 1;
+        double theta = acos(std::min(1.0, sign*dot));
+        double wa = theta < 1e-9 ? 1 - t : sin((1 - t)*theta)/sin(theta);
+        double wb = theta < 1e-9 ? t : sin(t*theta)/sin(theta);
+        for(int i=0;i<4;i++){out[i] = wa*a[i] + sign*wb*b[i];}
+    };
+
+    // Rotations Are Equal When the Quaternions Are Equal up to Sign
+    auto check_rotation = [](const quaternion<float> &value, const double *expect, double tolerance){
+        const float *v = value.RawData();
+        double dot = 0;
+        for(int i=0;i<4;i++){dot += v[i]*expect[i];}
+        double sign = dot < 0 ? -1 : 1;
+        for(int i=0;i<4;i++){
+            CHECK(fabs(v[i] - sign*expect[i]) < tolerance);
+        }
+    };
+
+    const int key_count = 5;
+    float times[key_count] = {0, 0.5, 1.25, 2, 4};
+    quaternion<float> keys[key_count];
+    keys[0] = quaternion<float>{1, 0.2, 0.1, 0};
+    keys[1] = quaternion<float>{0.3, -1, 0.4, 0.2};
+    keys[2] = quaternion<float>{-0.3, 1, -0.4, -0.25}; // Nearly Antipodal to keys[1]
+    keys[3] = quaternion<float>{0.1, 0.2, 1, -0.7};
+    keys[4] = quaternion<float>{-0.8, 0.1, 0.3, 0.5};
+
+    quaternion_tracks<float> tracks;
+    const int track_count = 150;
+    for(int i=0;i<track_count;i++){
+        // Tracks Offset in Time so Each Sits in a Different Segment
+        float offset_times[key_count];
+        for(int j=0;j<key_count;j++){offset_times[j] = times[j] + 0.01f*i;}
+        CHECK(tracks.Add(offset_times, keys, key_count) == (size_t)i);
+    }
+    CHECK(tracks.Size() == (size_t)track_count);
+    CHECK(tracks.KeyCount(3) == (size_t)key_count);
+
+    auto expected_segment = [&](int track, float time, double &t){
+        float shift = 0.01f*track;
+        int segment = 0;
+        while(segment < key_count - 2 && time >= times[segment + 1] + shift){segment++;}
+        t = (time - (times[segment] + shift))/((times[segment + 1] + shift) - (times[segment] + shift));
+        t = std::min(1.0, std::max(0.0, t));
+        return segment;
+    };
+
+    quaternion_array<float> out;
+
+    SUBCASE("Slerp Monotonic Playback and Seeks"){
+        float sample_times[9] = {-1, 0.1, 0.6, 0.61, 1.9, 3.7, 5, 0.3, 2.5};
+        for(float time : sample_times){
+            tracks.Sample(time, out, interpolate_slerp);
+            REQUIRE(out.Size() == (size_t)track_count);
+            for(int i=0;i<track_count;i+=7){
+                double t;
+                int segment = expected_segment(i, time, t);
+                double expect[4];
+                reference_slerp(keys[segment], keys[segment + 1], t, expect);
+                check_rotation(out.Get(i), expect, 0.00002);
+            }
+        }
+    }
+
+    SUBCASE("Nlerp"){
+        tracks.Sample(1.6, out, interpolate_nlerp);
+        for(int i=0;i<track_count;i+=7){
+            double t;
+            int segment = expected_segment(i, 1.6, t);
+            const float *a = keys[segment].RawData();
+            const float *b = keys[segment + 1].RawData();
+            double dot = 0;
+            for(int j=0;j<4;j++){dot += a[j]*b[j];}
+            double sign = dot < 0 ? -1 : 1;
+            double expect[4];
+            double magnitude = 0;
+            for(int j=0;j<4;j++){
+                expect[j] = a[j] + t*(sign*b[j] - a[j]);
+                magnitude += expect[j]*expect[j];
+            }
+            for(int j=0;j<4;j++){expect[j] /= sqrt(magnitude);}
+            check_rotation(out.Get(i), expect, 0.00001);
+        }
+    }
+
+    SUBCASE("Squad Passes Through Keys"){
+        for(int j=0;j<key_count;j++){
+            quaternion<float> value = tracks.Sample(0, times[j], interpolate_squad);
+            double expect[4];
+            for(int k=0;k<4;k++){expect[k] = keys[j].RawData()[k];}
+            check_rotation(value, expect, 0.00002);
+        }
+
+        // Continuous Across a Key
+        quaternion<float> before = tracks.Sample(0, 1.2499, interpolate_squad);
+        quaternion<float> after = tracks.Sample(0, 1.2501, interpolate_squad);
+        double expect[4];
+        for(int k=0;k<4;k++){expect[k] = before.RawData()[k];}
+        check_rotation(after, expect, 0.001);
+
+        // Unit Length
+        tracks.Sample(2.9, out, interpolate_squad);
+        for(int i=0;i<track_count;i++){
+            quaternion<float> value = out.Get(i);
+            float magnitude = 0;
+            for(int k=0;k<4;k++){magnitude += value[k]*value[k];}
+            CHECK(magnitude == doctest::Approx(1).epsilon(0.0001));
+        }
+    }
+
+    SUBCASE("Single Track Matches Array"){
+        tracks.Sample(2.2, out, interpolate_slerp);
+        quaternion<float> value = tracks.Sample(42, 2.2, interpolate_slerp);
+        for(int i=0;i<4;i++){
+            CHECK(value[i] == out.RawData(i)[42]);
+        }
+        CHECK_THROWS(tracks.Sample(track_count, 2.2));
+    }
+
+    SUBCASE("Single Key and Bad Times"){
+        quaternion_tracks<float> single;
+        single.Add(times, keys + 3, 1);
+        quaternion<float> value = single.Sample(0, 7, interpolate_squad);
+        double expect[4];
+        for(int k=0;k<4;k++){expect[k] = keys[3].RawData()[k];}
+        check_rotation(value, expect, 0.000001);
+
+        float bad_times[3] = {0, 1, 1};
+        CHECK_THROWS(single.Add(bad_times, keys, 3));
+        CHECK_THROWS(single.Add(bad_times, keys, 0));
+    }
+}
+
+
+TEST_CASE("arcball_recorder && arcball_replay"){
+    const char *path = "test_recording.agpr";
+    const int frame_count = 500;
+
+    arcball arc;
+    arc.SetViewArea(800, 600);
+    arc.SetProjectionVars(1.1, 0.1, 200);
+    float camera_position[3] = {2, 3, 9};
+    float up_vec[3] = {0, 1, 0};
+    arc.SetCamera(camera_position, up_vec);
+
+    std::vector<float> expect(16*frame_count);
+    {
+        arcball_recorder recorder(path);
+        for(int i=0;i<frame_count;i++){
+            arc.Rotate(3.1, -1.7);
+            if(i % 7 == 0){arc.Translate(2, 1);}
+            if(i % 11 == 0){arc.Zoom(5, -3, 0.5);}
+            if(i == 250){arc.SetProjectionVars(0.8, 0.5, 50);}
+            arc.ViewProjMatrix(&expect[16*i]);
+            recorder.Record(0.01*i, arc);
+        }
+        CHECK(recorder.FrameCount() == frame_count);
+    }
+
+    SUBCASE("Replay Matches Exactly"){
+        arcball_replay replay(path);
+        REQUIRE(replay.FrameCount() == frame_count);
+
+        arcball target;
+        float value[16];
+        for(int i=frame_count-1;i>=0;i-=3){
+            replay.Frame(i, target);
+            target.ViewProjMatrix(value);
+            CHECK(memcmp(value, &expect[16*i], sizeof(value)) == 0);
+            CHECK(replay.Timestamp(i) == 0.01*i);
+        }
+        CHECK_THROWS(replay.Frame(frame_count, target));
+    }
+
+    SUBCASE("FrameAt()"){
+        arcball_replay replay(path);
+        CHECK(replay.FrameAt(-1) == 0);
+        CHECK(replay.FrameAt(0) == 0);
+        CHECK(replay.FrameAt(1.235) == 123);
+        CHECK(replay.FrameAt(100) == frame_count - 1);
+    }
+
+    SUBCASE("Bad Files"){
+        arcball_replay replay;
+        CHECK_THROWS(replay.Open("missing_recording.agpr"));
+
+        // Written on a Machine of the Other Byte Order
+        FILE *file = fopen(path, "r+b");
+        REQUIRE(file);
+        uint32_t byte_order_marks[2] = {0x04030201, 0x01020304};
+        fseek(file, 16, SEEK_SET);
+        fwrite(&byte_order_marks[0], sizeof(uint32_t), 1, file);
+        fclose(file);
+        CHECK_THROWS(replay.Open(path));
+
+        file = fopen(path, "r+b");
+        REQUIRE(file);
+        fseek(file, 16, SEEK_SET);
+        fwrite(&byte_order_marks[1], sizeof(uint32_t), 1, file);
+        uint32_t version = 99;
+        fseek(file, 8, SEEK_SET);
+        fwrite(&version, sizeof(version), 1, file);
+        fclose(file);
+        CHECK_THROWS(replay.Open(path));
+
+        file = fopen(path, "r+b");
+        REQUIRE(file);
+        fwrite("NOTACAMS", 1, 8, file);
+        fclose(file);
+        CHECK_THROWS(replay.Open(path));
+        CHECK(replay.FrameCount() == 0);
+    }
+
+    std::remove(path);
+}
+
+
+TEST_CASE("quaternion_arcball"){
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+
+    auto set_vars = [&](arcball &arc, quaternion_arcball &quat_arc){
+        arc.SetViewArea(1600, 900);
+        quat_arc.SetViewArea(1600, 900);
+        arc.SetProjectionVars(1.1, 0.1, 100);
+        quat_arc.SetProjectionVars(1.1, 0.1, 100);
+        arc.SetCamera(camera_position, up_vec);
+        quat_arc.SetCamera(camera_position, up_vec);
+    };
+
+    auto check_matrices = [](arcball &arc, quaternion_arcball &quat_arc, const float tolerance){
+        float expect[16];
+        float value[16];
+        arc.ViewProjMatrix(expect);
+        quat_arc.ViewProjMatrix(value);
+        for(int i=0;i<16;i++){
+            CHECK(fabs(value[i] - expect[i]) <= tolerance*(1 + fabs(expect[i])));
+        }
+
+        float inverse[16];
+        float transposed[16];
+        float product[16];
+        quat_arc.InverseViewProjMatrix(inverse);
+        TransposeMat4(inverse, transposed);
+        Mat4MultiplyMat4T(value, transposed, product);
+        for(int i=0;i<16;i++){
+            CHECK(fabs(product[i] - (i % 5 == 0 ? 1 : 0)) <= 0.00001);
+        }
+
+        float columns[16];
+        quat_arc.ViewProjMatrix(columns, column_major);
+        for(int i=0;i<16;i++){
+            CHECK(columns[4*(i % 4) + i/4] == value[i]);
+        }
+    };
+
+    auto check_orthonormal = [](quaternion_arcball &quat_arc, const float tolerance){
+        const float *basis = quat_arc.Basis();
+        for(int i=0;i<3;i++){
+            for(int j=0;j<3;j++){
+                CHECK(fabs(DotVec<3>(basis + 3*i, basis + 3*j) - (i == j ? 1 : 0)) <= tolerance);
+            }
+        }
+    };
+
+    SUBCASE("Matches arcball"){
+        arcball arc;
+        quaternion_arcball quat_arc;
+        check_matrices(arc, quat_arc, 0.000001);
+
+        set_vars(arc, quat_arc);
+        check_matrices(arc, quat_arc, 0.00001);
+
+        float ray[3];
+        float expect_ray[3];
+        arc.MouseRay(120, -45, expect_ray);
+        quat_arc.MouseRay(120, -45, ray);
+        for(int i=0;i<3;i++){
+            CHECK(ray[i] == doctest::Approx(expect_ray[i]).epsilon(0.00001));
+        }
+
+        // Shared Through arcball_view
+        float tile[3][4];
+        quat_arc.MouseRays(120, -45, 2, 2, tile[0], tile[1], tile[2], 2);
+        for(int i=0;i<3;i++){
+            CHECK(tile[i][0] == doctest::Approx(ray[i]).epsilon(0.00001));
+        }
+
+        arc.Translate(14, -3);
+        quat_arc.Translate(14, -3);
+        arc.Zoom(30, 20, -2);
+        quat_arc.Zoom(30, 20, -2);
+        arc.Zoom(0, 0, 1.5);
+        quat_arc.Zoom(0, 0, 1.5);
+        check_matrices(arc, quat_arc, 0.00001);
+        CHECK(quat_arc.Radius() == doctest::Approx(arc.Radius()).epsilon(0.00001));
+
+        // arcball Moves the Up Vector to First Order, so Small Rotations Agree Closely
+        arc.Rotate(1.5, -0.8);
+        quat_arc.Rotate(1.5, -0.8);
+        check_matrices(arc, quat_arc, 0.0001);
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Camera()[i] == doctest::Approx(arc.Camera()[i]).epsilon(0.00001));
+        }
+
+        arcball_state state;
+        quat_arc.GetState(state);
+        arcball restored;
+        restored.SetState(state);
+        check_matrices(restored, quat_arc, 0.00001);
+    }
+
+    SUBCASE("Exact Rotations"){
+        quaternion_arcball quat_arc;
+        float start[3];
+        std::copy(camera_position, camera_position + 3, start);
+        quat_arc.SetCamera(camera_position, up_vec);
+
+        // Rotating by +d Then -d Returns to the Start
+        quat_arc.Rotate(40, 25);
+        quat_arc.Rotate(-40, -25);
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Camera()[i] == doctest::Approx(start[i]).epsilon(0.00001));
+        }
+
+        // A Full Turn About the Local y Axis
+        float radius = quat_arc.Radius();
+        for(int i=0;i<100;i++){
+            quat_arc.Rotate(2*3.14159265f/(100*quat_arc.rotate_sensitivity), 0);
+        }
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Camera()[i] == doctest::Approx(start[i]).epsilon(0.0001));
+        }
+        CHECK(quat_arc.Radius() == radius);
+    }
+
+    SUBCASE("No Drift in Long Sessions"){
+        quaternion_arcball quat_arc;
+        quat_arc.SetCamera(camera_position, up_vec);
+        for(int i=0;i<100000;i++){
+            quat_arc.Rotate<math_fast>(7.3*sin(0.01*i), 5.1*cos(0.013*i));
+        }
+        check_orthonormal(quat_arc, 0.000002);
+        float offset[3];
+        DiffVec<3>(quat_arc.Camera(), quat_arc.Center(), offset);
+        CHECK(MagnitudeVec<3>(offset) == doctest::Approx(quat_arc.Radius()).epsilon(0.00001));
+    }
+
+    SUBCASE("SetCenter() Keeps the Camera"){
+        quaternion_arcball quat_arc;
+        quat_arc.SetCamera(camera_position, up_vec);
+        quat_arc.SetCenter(center_position);
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Camera()[i] == doctest::Approx(camera_position[i]).epsilon(0.00001));
+        }
+        check_orthonormal(quat_arc, 0.000001);
+
+        float parallel[3] = {0.3, 1.5, 5};
+        CHECK_THROWS(quat_arc.SetCamera(parallel, up_vec));
+        CHECK_THROWS(quat_arc.SetCamera(center_position, up_vec));
+        CHECK_THROWS(quat_arc.SetRadius(-1));
+
+        // A Center Along the Up Vector Throws and Leaves the View As it Was
+        float above[3];
+        for(int i=0;i<3;i++){
+            above[i] = quat_arc.Camera()[i] + 2*quat_arc.Basis()[i + 3];
+        }
+        float before[16];
+        float after[16];
+        quat_arc.ViewProjMatrix(before);
+        CHECK_THROWS(quat_arc.SetCenter(above));
+        quat_arc.ViewProjMatrix(after);
+        for(int i=0;i<16;i++){
+            CHECK(after[i] == before[i]);
+        }
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Center()[i] == center_position[i]);
+        }
+    }
+}
+
+TEST_CASE("Try Functions"){
+    float camera_position[3] = {1.41, 2.05, 4.39};
+    float up_vec[3] = {0, 0, 1};
+    float center_position[3] = {0.3, 1.5, 0.083};
+    float parallel[3] = {0, 0, 5};
+
+    SUBCASE("StatusMessage()"){
+        CHECK(std::string(StatusMessage(status_parallel_vectors)) == "Camera and Up Vectors Parallel");
+        CHECK(std::string(StatusMessage(status_negative_radius)) == "Radius Negative");
+        CHECK_NOTHROW(ThrowOnError(status_ok));
+        CHECK_THROWS(ThrowOnError(status_nlerp_undefined));
+    }
+
+    SUBCASE("arcball"){
+        arcball arc;
+        CHECK(arc.TrySetCamera(camera_position, up_vec) == status_ok);
+        float before[16];
+        float after[16];
+        arc.ViewProjMatrix(before);
+
+        CHECK(arc.TrySetCamera(parallel, up_vec) == status_parallel_vectors);
+        CHECK(arc.TrySetRadius(-2) == status_negative_radius);
+        arc.ViewProjMatrix(after);
+        for(int i=0;i<16;i++){
+            CHECK(after[i] == before[i]);
+        }
+        CHECK_THROWS(arc.SetCamera(parallel, up_vec));
+        CHECK_THROWS(arc.SetRadius(-2));
+
+        CHECK(arc.TrySetRadius<error_clamp>(-2) == status_ok);
+        CHECK(arc.Radius() == doctest::Approx(.001));
+        CHECK(arc.TrySetRadius(3) == status_ok);
+        CHECK(arc.Radius() == 3);
+
+        static_assert(noexcept(arc.TrySetCamera(camera_position, up_vec)), "TrySetCamera() Throws");
+        static_assert(noexcept(arc.TrySetRadius<error_clamp>(1)), "TrySetRadius() Throws");
+    }
+
+    SUBCASE("quaternion_arcball"){
+        quaternion_arcball quat_arc;
+        CHECK(quat_arc.TrySetCamera(camera_position, up_vec) == status_ok);
+        float radius = quat_arc.Radius();
+        quaternion<float> orientation = quat_arc.Orientation();
+
+        quat_arc.SetCenter(center_position);
+        float far_parallel[3] = {0.3, 1.5, 5};
+        CHECK(quat_arc.TrySetCamera(far_parallel, up_vec) == status_parallel_vectors);
+        CHECK(quat_arc.TrySetCamera(center_position, up_vec) == status_camera_at_center);
+        CHECK(quat_arc.TrySetRadius(-1) == status_negative_radius);
+        CHECK(quat_arc.TrySetRadius<error_clamp>(-1) == status_ok);
+        CHECK(quat_arc.Radius() == doctest::Approx(.001));
+        CHECK(quat_arc.TrySetRadius(radius) == status_ok);
+
+        // error_clamp Pitches Straight Toward a Center Along the Up Vector
+        float camera[3];
+        float basis[9];
+        float above[3];
+        std::copy(quat_arc.Camera(), quat_arc.Camera() + 3, camera);
+        std::copy(quat_arc.Basis(), quat_arc.Basis() + 9, basis);
+        for(int i=0;i<3;i++){
+            above[i] = camera[i] + 2*basis[i + 3];
+        }
+        CHECK(quat_arc.TrySetCenter(camera) == status_camera_at_center);
+        CHECK(quat_arc.TrySetCenter(above) == status_parallel_vectors);
+        CHECK(quat_arc.Radius() == radius);
+        CHECK(quat_arc.TrySetCenter<error_clamp>(above) == status_ok);
+        CHECK(quat_arc.Radius() == doctest::Approx(2));
+        for(int i=0;i<3;i++){
+            CHECK(quat_arc.Camera()[i] == doctest::Approx(camera[i]).epsilon(0.00001));
+            CHECK(quat_arc.Basis()[i] == doctest::Approx(basis[i]).epsilon(0.00001));
+            CHECK(quat_arc.Basis()[i + 3] == doctest::Approx(basis[i + 6]).epsilon(0.00001));
+            CHECK(quat_arc.Basis()[i + 6] == doctest::Approx(-basis[i + 3]).epsilon(0.00001));
+        }
+        static_assert(noexcept(quat_arc.TrySetCenter(above)), "TrySetCenter() Throws");
+
+        quaternion_arcball unchanged;
+        unchanged.SetCamera(camera_position, up_vec);
+        CHECK(unchanged.TrySetCamera(parallel, up_vec) == status_parallel_vectors);
+        CHECK(unchanged.Radius() == radius);
+        for(int i=0;i<4;i++){
+            CHECK(unchanged.Orientation().RawData()[i] == orientation.RawData()[i]);
+        }
+    }
+
+    SUBCASE("quaternion"){
+        quaternion<float> q1{1, 2, 3, 4};
+        quaternion<float> q2{4, -3, 2, 1};
+        quaternion<float> opposite{-1, -2, -3, -4};
+
+        float value = 0;
+        CHECK(q1.TryGet(3, value) == status_ok);
+        CHECK(value == q1[3]);
+        CHECK(q1.TryGet(4, value) == status_index_out_of_bounds);
+        CHECK(q1.TryGet(-1, value) == status_index_out_of_bounds);
+        CHECK(q1.TryGet<error_clamp>(-1, value) == status_ok);
+        CHECK(value == q1[0]);
+        CHECK(q1.TryGet<error_clamp>(9, value) == status_ok);
+        CHECK(value == q1[3]);
+        CHECK_THROWS(q1[4]);
+        CHECK_THROWS(q1[-1]);
+        CHECK_NOTHROW(q1[0]);
+
+        quaternion<float> expect;
+        quaternion<float> output;
+        expect.nlerp(q1, q2, .3);
+        CHECK(output.TryNlerp(q1, q2, .3) == status_ok);
+        for(int i=0;i<4;i++){
+            CHECK(output[i] == expect[i]);
+        }
+        CHECK(output.TryNlerp(q1, q2, 1.5) == status_percentage_out_of_bounds);
+        CHECK(output.TryNlerp(q1, opposite, .3) == status_nlerp_undefined);
+        for(int i=0;i<4;i++){
+            CHECK(output[i] == expect[i]);
+        }
+
+        expect.nlerp(q1, q2, 1);
+        CHECK(output.TryNlerp<error_clamp>(q1, q2, 1.5) == status_ok);
+        for(int i=0;i<4;i++){
+            CHECK(output[i] == expect[i]);
+        }
+        CHECK(output.TryNlerp<error_clamp>(q1, opposite, .3) == status_nlerp_undefined);
+
+        static_assert(noexcept(q1.TryGet(0, value)), "TryGet() Throws");
+        static_assert(noexcept(output.TryNlerp(q1, q2, .3)), "TryNlerp() Throws");
+    }
+
+    SUBCASE("quaternion_array"){
+        const int count = 5;
+        quaternion_array<float> array1(count);
+        quaternion_array<float> array2(count);
+        for(int i=0;i<count;i++){
+            array1.Set(i, quaternion<float>{1.0f + i, 2, 3, 4});
+            array2.Set(i, quaternion<float>{4, -3, 2.0f - i, 1});
+        }
+
+        quaternion_array<float> expect;
+        expect.nlerp(array1, array2, .4);
+        CHECK(expect.Size() == (size_t)count);
+
+        quaternion_array<float> output;
+        CHECK(output.TryNlerp(array1, array2, .4) == status_size_mismatch);
+        CHECK(output.Size() == 0);
+        output.Resize(count);
+        CHECK(output.TryNlerp(array1, array2, .4) == status_ok);
+        for(int i=0;i<count;i++){
+            for(int j=0;j<4;j++){
+                CHECK(output.RawData(j)[i] == expect.RawData(j)[i]);
+            }
+        }
+        CHECK(output.TryNlerp(array1, array2, -1) == status_percentage_out_of_bounds);
+        CHECK(output.TryNlerp<error_clamp>(array1, array2, -1) == status_ok);
+        for(int i=0;i<count;i++){
+            for(int j=0;j<4;j++){
+                CHECK(output.RawData(j)[i] == doctest::Approx(array1.RawData(j)[i]).epsilon(0.000001));
+            }
+        }
+
+        array2.Set(2, quaternion<float>{-3, -2, -3, -4});
+        CHECK(output.TryNlerp(array1, array2, .4) == status_nlerp_undefined);
+        CHECK_THROWS(output.nlerp(array1, array2, .4));
+
+        // A Shorter q2 is Reported Before Any of it is Read
+        quaternion_array<float> shorter(count - 1);
+        CHECK(output.TryNlerp(array1, shorter, .4) == status_size_mismatch);
+        CHECK(output.TryNlerp(array1, shorter, 2) == status_size_mismatch);
+        CHECK_THROWS(output.nlerp(array1, shorter, .4));
+        CHECK(output.Size() == (size_t)count);
+    }
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2021 Matthew Elks
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Built as its Own Test Program so test_agp_h.cpp Covers the Default
+// Build and This Covers the Tracing Hooks
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include"./doctest/doctest.h"
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#define AGP_ENABLE_TRACING
+#include"../libs/agp/agp.h"
+#include<string>
+#include<sstream>
+#include<fstream>
+#include<cstdio>
+
+
+TEST_CASE("Tracing"){
+    TraceReset();
+
+    arcball arc;
+    float matrix[16];
+    for(int i=0;i<10;i++){
+        arc.Rotate(4.4, -1.3);
+        arc.Rotate<math_fast>(-4.4, 1.3);
+        if(i % 2 == 0){arc.ViewProjMatrix(matrix);}
+        AGP_TRACE_FRAME();
+    }
+
+    std::vector<float> points(3*100000, 1);
+    quaternion<float> quat;
+    quat.SetWithEuler(0.1, 0.2, 0.3);
+    thread_pool pool(3);
+    RotatePoints(quat, points.data(), points.data(), 100000, pool);
+
+    std::vector<trace_stats> stats = TraceStats();
+    const trace_stats *rotate = 0;
+    const trace_stats *view_proj = 0;
+    const trace_stats *rotate_points = 0;
+    for(size_t i=0;i<stats.size();i++){
+        if(std::string(stats[i].name) == "arcball::Rotate"){rotate = &stats[i];}
+        if(std::string(stats[i].name) == "arcball::ViewProjMatrix"){view_proj = &stats[i];}
+        if(std::string(stats[i].name) == "RotatePoints"){rotate_points = &stats[i];}
+    }
+    REQUIRE(rotate);
+    REQUIRE(view_proj);
+    REQUIRE(rotate_points);
+
+    SUBCASE("Counts and Histograms"){
+        // Both Math Policies Share One Site
+        CHECK(rotate->calls == 20);
+        CHECK(rotate->cycles > 0);
+        CHECK(view_proj->calls == 5);
+        CHECK(rotate_points->calls == 1);
+
+        uint64_t rotate_frames = 0;
+        uint64_t view_proj_frames = 0;
+        for(int i=0;i<trace_histogram_bins;i++){
+            rotate_frames += rotate->histogram[i];
+            view_proj_frames += view_proj->histogram[i];
+        }
+        CHECK(rotate_frames == 10);
+        CHECK(view_proj_frames == 5);
+    }
+
+    SUBCASE("Chrome Trace"){
+        const char *path = "test_trace.json";
+        TraceWriteChrome(path);
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents<<file.rdbuf();
+        std::string text = contents.str();
+        file.close();
+        std::remove(path);
+
+        CHECK(text.find("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [") == 0);
+        size_t events = 0;
+        size_t rotate_events = 0;
+        for(size_t at = text.find("\"ph\": \"X\""); at != std::string::npos; at = text.find("\"ph\": \"X\"", at + 1)){
+            events++;
+        }
+        for(size_t at = text.find("arcball::Rotate"); at != std::string::npos; at = text.find("arcball::Rotate", at + 1)){
+            rotate_events++;
+        }
+        uint64_t calls = 0;
+        for(size_t i=0;i<stats.size();i++){calls += stats[i].calls;}
+        CHECK(events == calls);
+        CHECK(rotate_events == 20);
+        CHECK(text.substr(text.size() - 4) == "\n]}\n");
+    }
+
+    SUBCASE("Reset"){
+        TraceReset();
+        stats = TraceStats();
+        for(size_t i=0;i<stats.size();i++){
+            CHECK(stats[i].calls == 0);
+        }
+    }
+}
+
+
+TEST_CASE("Try Functions are Not Traced"){
+    TraceReset();
+
+    arcball arc;
+    float cam_pos[3] = {0, 3, 1};
+    float up[3] = {0, 0, 1};
+    arc.SetCamera(cam_pos, up);
+    for(int i=0;i<5;i++){
+        arc.TrySetCamera(cam_pos, up);
+    }
+
+    quaternion<float> quat;
+    quat.SetWithEuler(0.1, 0.2, 0.3);
+    quaternion_array<float> q1;
+    q1.Resize(8);
+    for(size_t i=0;i<8;i++){q1.Set(i, quat);}
+    quaternion_array<float> output;
+    output.nlerp(q1, q1, 0.5);
+    output.TryNlerp(q1, q1, 0.5);
+
+    std::vector<trace_stats> stats = TraceStats();
+    uint64_t set_camera_calls = 0;
+    uint64_t nlerp_calls = 0;
+    for(size_t i=0;i<stats.size();i++){
+        if(std::string(stats[i].name) == "arcball::SetCamera"){set_camera_calls = stats[i].calls;}
+        if(std::string(stats[i].name) == "quaternion_array::nlerp"){nlerp_calls = stats[i].calls;}
+    }
+    CHECK(set_camera_calls == 1);
+    CHECK(nlerp_calls == 1);
+}